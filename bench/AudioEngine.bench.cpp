@@ -0,0 +1,121 @@
+#include <benchmark/benchmark.h>
+#include <MaizeMix.h>
+
+#include <vector>
+
+#include "BenchClips.h"
+
+// every benchmark runs on the offline backend so no audio device is needed
+namespace {
+
+	constexpr uint32_t c_Voices = 1024; // anything past this is virtual
+	constexpr size_t c_BlockFrames = 512;
+
+	const Mix::AudioSpecification c_Spec(true, false, 100, 1);
+
+	void PlayMany(Mix::AudioEngine& engine, const Mix::AudioClip& clip, int64_t count)
+	{
+		for (int64_t i = 0; i < count; i++)
+		{
+			engine.PlayAudio(static_cast<uint64_t>(i), clip, c_Spec);
+		}
+	}
+
+}
+
+static void PlayStopChurn(benchmark::State& state)
+{
+	Mix::AudioEngine engine(Mix::AudioEngine::Backend::Offline, c_Voices);
+	const auto clip = engine.CreateClip(Bench::c_WavClip, false);
+	uint64_t entityID = 0;
+
+	for (auto _ : state)
+	{
+		benchmark::DoNotOptimize(engine.PlayAudio(entityID, clip, c_Spec));
+		engine.StopAudio(entityID);
+
+		entityID++;
+	}
+
+	state.SetItemsProcessed(state.iterations());
+}
+
+static void EntitySetters(benchmark::State& state)
+{
+	Mix::AudioEngine engine(Mix::AudioEngine::Backend::Offline, c_Voices);
+	const auto clip = engine.CreateClip(Bench::c_WavClip, false);
+
+	PlayMany(engine, clip, state.range(0));
+
+	for (auto _ : state)
+	{
+		for (int64_t i = 0; i < state.range(0); i++)
+		{
+			const auto entityID = static_cast<uint64_t>(i);
+
+			engine.SetAudioVolume(entityID, 50);
+			engine.SetAudioPitch(entityID, 1.5f);
+			engine.SetAudioPosition(entityID, 1, 2, 3);
+		}
+	}
+
+	state.SetItemsProcessed(state.iterations() * state.range(0) * 3);
+}
+
+static void Update(benchmark::State& state)
+{
+	Mix::AudioEngine engine(Mix::AudioEngine::Backend::Offline, c_Voices);
+	const auto clip = engine.CreateClip(Bench::c_WavClip, false);
+
+	PlayMany(engine, clip, state.range(0));
+
+	for (auto _ : state)
+	{
+		engine.Update(1.0f / 60.0f);
+	}
+
+	state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+static void Render(benchmark::State& state)
+{
+	Mix::AudioEngine engine(Mix::AudioEngine::Backend::Offline, c_Voices);
+	const auto clip = engine.CreateClip(Bench::c_WavClip, false);
+	std::vector<sf::Int16> output(c_BlockFrames * Mix::Mixer::c_ChannelCount);
+
+	PlayMany(engine, clip, state.range(0));
+
+	for (auto _ : state)
+	{
+		engine.Render(output.data(), c_BlockFrames);
+	}
+
+	// frames per second of mixed output, real time is 44100
+	state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(c_BlockFrames));
+}
+
+// from PlayAudio until the first block of a streamed clip has been mixed
+static void StreamStart(benchmark::State& state)
+{
+	Mix::AudioEngine engine(Mix::AudioEngine::Backend::Offline, c_Voices);
+	const auto clip = engine.CreateClip(state.range(0) == 0 ? Bench::c_WavClip : Bench::c_OggClip, true);
+	std::vector<sf::Int16> output(c_BlockFrames * Mix::Mixer::c_ChannelCount);
+
+	for (auto _ : state)
+	{
+		engine.PlayAudio(0, clip, c_Spec);
+		engine.Render(output.data(), c_BlockFrames);
+
+		state.PauseTiming();
+		engine.StopAudio(0);
+		state.ResumeTiming();
+	}
+
+	state.SetLabel(state.range(0) == 0 ? "wav" : "ogg");
+}
+
+BENCHMARK(PlayStopChurn);
+BENCHMARK(EntitySetters)->Arg(1000);
+BENCHMARK(Update)->RangeMultiplier(10)->Range(10, 10000);
+BENCHMARK(Render)->RangeMultiplier(10)->Range(10, 1000);
+BENCHMARK(StreamStart)->DenseRange(0, 1)->Unit(benchmark::kMicrosecond);
\ No newline at end of file
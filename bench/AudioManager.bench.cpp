@@ -0,0 +1,25 @@
+#include <benchmark/benchmark.h>
+#include <MaizeMix.h>
+
+#include "BenchClips.h"
+
+// range(0) picks wav or ogg, range(1) buffered or streamed
+static void CreateClip(benchmark::State& state)
+{
+	Mix::AudioEngine engine(Mix::AudioEngine::Backend::Offline);
+	const std::string& filePath = state.range(0) == 0 ? Bench::c_WavClip : Bench::c_OggClip;
+	const bool stream = state.range(1) != 0;
+
+	for (auto _ : state)
+	{
+		// the clip is released every time, so nothing is served from the cache
+		auto clip = engine.CreateClip(filePath, stream);
+
+		benchmark::DoNotOptimize(clip);
+		engine.RemoveClip(clip);
+	}
+
+	state.SetLabel(std::string(state.range(0) == 0 ? "wav" : "ogg") + (stream ? " streamed" : " buffered"));
+}
+
+BENCHMARK(CreateClip)->ArgsProduct({ { 0, 1 }, { 0, 1 } })->Unit(benchmark::kMicrosecond);
\ No newline at end of file
@@ -0,0 +1,13 @@
+#pragma once
+
+#include <string>
+
+namespace Bench {
+
+	// the test clips, the ogg one is converted from the wav one when the benchmarks start
+	inline const std::string c_WavClip = "Clips/Pew.wav";
+	inline const std::string c_OggClip = "Clips/Pew.ogg";
+
+	bool PrepareClips();
+
+} // Bench
\ No newline at end of file
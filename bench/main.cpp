@@ -0,0 +1,46 @@
+#include <benchmark/benchmark.h>
+#include <SFML/Audio.hpp>
+#include <iostream>
+#include <vector>
+
+#include "BenchClips.h"
+
+namespace Bench {
+
+	bool PrepareClips()
+	{
+		sf::InputSoundFile input;
+		sf::OutputSoundFile output;
+
+		if (!input.openFromFile(c_WavClip)) return false;
+		if (!output.openFromFile(c_OggClip, input.getSampleRate(), input.getChannelCount())) return false;
+
+		std::vector<sf::Int16> samples(4096 * input.getChannelCount());
+
+		while (const sf::Uint64 count = input.read(samples.data(), samples.size()))
+		{
+			output.write(samples.data(), count);
+		}
+
+		return true;
+	}
+
+} // Bench
+
+int main(int argc, char** argv)
+{
+	benchmark::Initialize(&argc, argv);
+
+	if (benchmark::ReportUnrecognizedArguments(argc, argv)) return 1;
+
+	if (!Bench::PrepareClips())
+	{
+		std::cerr << "Failed to prepare " << Bench::c_OggClip << " from " << Bench::c_WavClip << std::endl;
+		return 1;
+	}
+
+	benchmark::RunSpecifiedBenchmarks();
+	benchmark::Shutdown();
+
+	return 0;
+}
\ No newline at end of file
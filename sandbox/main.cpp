@@ -95,13 +95,14 @@ void UpdatePlayingAudio(flecs::entity entity, AudioSource& source, AudioSourcePl
 
 	engine->Update(deltaTime);
 
-	engine->SetAudioLoopState(entity, source.loop);
-	engine->SetAudioMuteState(entity, source.mute);
-	engine->SetAudioVolume(entity, source.volume);
-	engine->SetAudioPitch(entity, source.pitch);
-
-	engine->SetAudioOffsetTime(entity, source.time);
-	source.time = engine->GetAudioOffsetTime(entity);
+	const auto spec = Mix::AudioSpecification(
+			source.loop,
+			source.mute,
+			source.volume,
+			source.pitch
+		);
+
+	engine->SyncSource(entity, spec, source.time);
 }
 
 void AudioConfig(flecs::entity entity, AudioSource& source, const AudioClips& clips)
@@ -1,5 +1,7 @@
 #pragma once
 
 #include "MaizeMix/Helper/AudioSpecification.h"
+#include "MaizeMix/Helper/AudioStats.h"
+#include "MaizeMix/AudioCommandBuffer.h"
 #include "MaizeMix/AudioEngine.h"
 #include "MaizeMix/AudioClip.h"
\ No newline at end of file
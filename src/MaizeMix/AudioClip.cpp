@@ -4,7 +4,7 @@ namespace Mix {
 
     uint32_t AudioClip::GetChannel() const
     {
-        if (const auto handle = m_Handle.lock())
+        if (const auto handle = m_Handle.lock(); handle && handle->IsLoaded())
         {
             return handle->GetChannelCount();
         }
@@ -14,7 +14,7 @@ namespace Mix {
 
     float AudioClip::GetDuration() const
     {
-        if (const auto handle = m_Handle.lock())
+        if (const auto handle = m_Handle.lock(); handle && handle->IsLoaded())
         {
             return handle->GetDuration().asSeconds();
         }
@@ -24,7 +24,7 @@ namespace Mix {
 
     uint32_t AudioClip::GetFrequency() const
     {
-        if (const auto handle = m_Handle.lock())
+        if (const auto handle = m_Handle.lock(); handle && handle->IsLoaded())
         {
             return handle->GetSampleRate();
         }
@@ -34,7 +34,7 @@ namespace Mix {
 
     uint64_t AudioClip::GetSampleCount() const
     {
-        if (const auto handle = m_Handle.lock())
+        if (const auto handle = m_Handle.lock(); handle && handle->IsLoaded())
         {
             return handle->GetSampleCount();
         }
@@ -42,13 +42,45 @@ namespace Mix {
         return 0;
     }
 
+    size_t AudioClip::GetMemoryUsage() const
+    {
+        if (const auto handle = m_Handle.lock(); handle && handle->IsLoaded())
+        {
+            return handle->GetMemoryUsage();
+        }
+
+        return 0;
+    }
+
+    float AudioClip::GetLoadTime() const
+    {
+        if (const auto handle = m_Handle.lock(); handle && handle->IsLoaded())
+        {
+            return handle->GetLoadTime();
+        }
+
+        return 0;
+    }
+
     bool AudioClip::IsLoadInBackground() const
     {
-        return m_IsStreaming;
+        // anything that isn't decompressed up front is decoded while it plays
+        return m_LoadType != LoadType::DecompressOnLoad;
+    }
+
+    AudioClip::LoadType AudioClip::GetLoadType() const
+    {
+        return m_LoadType;
     }
 
     AudioClip::LoadState AudioClip::GetLoadState() const
     {
+        // the clip may have finished loading in the background since this was handed out
+        if (const auto handle = m_Handle.lock())
+        {
+            return handle->GetState();
+        }
+
         return m_LoadState;
     }
 
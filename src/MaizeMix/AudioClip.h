@@ -11,29 +11,33 @@ namespace Mix {
     public:
         AudioClip() = default;
 
-        enum class LoadState { Unloaded = 0, Loaded, Failed };
+        using LoadState = Clip::State;
+        using LoadType = Clip::LoadType;
 
         uint32_t GetChannel() const;
         float GetDuration() const;
         uint32_t GetFrequency() const;
         uint64_t GetSampleCount() const;
+        size_t GetMemoryUsage() const;
+        float GetLoadTime() const;
         bool IsLoadInBackground() const;
         LoadState GetLoadState() const;
+        LoadType GetLoadType() const;
         bool IsValid() const;
 
     private:
         friend class AudioEngine;
         friend class AudioManager;
 
-        AudioClip(size_t clipID, const std::shared_ptr<Clip>& clip, bool stream, LoadState loadState) :
-            m_ClipID(clipID), m_Handle(clip), m_IsStreaming(stream), m_LoadState(loadState)
+        AudioClip(size_t clipID, const std::shared_ptr<Clip>& clip, LoadType loadType, LoadState loadState) :
+            m_ClipID(clipID), m_Handle(clip), m_LoadType(loadType), m_LoadState(loadState)
         {
         }
 
         size_t m_ClipID = 0;
         std::weak_ptr<Clip> m_Handle;
 
-        bool m_IsStreaming = false;
+        LoadType m_LoadType = LoadType::DecompressOnLoad;
         LoadState m_LoadState = LoadState::Unloaded;
     };
 
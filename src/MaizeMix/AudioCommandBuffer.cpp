@@ -0,0 +1,128 @@
+#include "MaizeMix/AudioCommandBuffer.h"
+
+namespace Mix {
+
+	void AudioCommandBuffer::PlayAudio(uint64_t entityID, const AudioClip& clip, const AudioSpecification& spec)
+	{
+		Record(entityID, CommandType::Play).integer = static_cast<int32_t>(m_Plays.size());
+
+		m_Plays.push_back({ clip, spec, std::nullopt });
+	}
+
+	void AudioCommandBuffer::PlayAudioAt(uint64_t entityID, const AudioClip& clip, const AudioSpecification& spec, uint64_t startTick)
+	{
+		Record(entityID, CommandType::Play).integer = static_cast<int32_t>(m_Plays.size());
+
+		m_Plays.push_back({ clip, spec, startTick });
+	}
+
+	void AudioCommandBuffer::PauseAudio(uint64_t entityID)
+	{
+		Record(entityID, CommandType::PauseState).flag = true;
+	}
+
+	void AudioCommandBuffer::UnpauseAudio(uint64_t entityID)
+	{
+		Record(entityID, CommandType::PauseState).flag = false;
+	}
+
+	void AudioCommandBuffer::StopAudio(uint64_t entityID)
+	{
+		Record(entityID, CommandType::Stop);
+	}
+
+	void AudioCommandBuffer::StopAudioAt(uint64_t entityID, uint64_t stopTick)
+	{
+		Record(entityID, CommandType::StopTick).tick = stopTick;
+	}
+
+	void AudioCommandBuffer::SetAudioLoopState(uint64_t entityID, bool loop)
+	{
+		Record(entityID, CommandType::LoopState).flag = loop;
+	}
+
+	void AudioCommandBuffer::SetAudioMuteState(uint64_t entityID, bool mute)
+	{
+		Record(entityID, CommandType::MuteState).flag = mute;
+	}
+
+	void AudioCommandBuffer::SetAudioVolume(uint64_t entityID, float volume)
+	{
+		Record(entityID, CommandType::Volume).values[0] = volume;
+	}
+
+	void AudioCommandBuffer::SetAudioPitch(uint64_t entityID, float pitch)
+	{
+		Record(entityID, CommandType::Pitch).values[0] = pitch;
+	}
+
+	void AudioCommandBuffer::SetAudioPriority(uint64_t entityID, int32_t priority)
+	{
+		Record(entityID, CommandType::Priority).integer = priority;
+	}
+
+	void AudioCommandBuffer::SetAudioPosition(uint64_t entityID, float x, float y, float depth)
+	{
+		auto& command = Record(entityID, CommandType::Position);
+
+		command.values[0] = x;
+		command.values[1] = y;
+		command.values[2] = depth;
+	}
+
+	void AudioCommandBuffer::SetAudioOffsetTime(uint64_t entityID, float time)
+	{
+		Record(entityID, CommandType::OffsetTime).values[0] = time;
+	}
+
+	void AudioCommandBuffer::Append(const AudioCommandBuffer& other)
+	{
+		const auto sequenceOffset = static_cast<uint32_t>(m_Commands.size());
+		const auto playOffset = static_cast<int32_t>(m_Plays.size());
+
+		// everything appended happens after what is already recorded
+		for (auto command : other.m_Commands)
+		{
+			command.sequence += sequenceOffset;
+
+			if (command.type == CommandType::Play) command.integer += playOffset;
+
+			m_Commands.push_back(command);
+		}
+
+		m_Plays.insert(m_Plays.end(), other.m_Plays.begin(), other.m_Plays.end());
+	}
+
+	void AudioCommandBuffer::Reserve(size_t commandCount)
+	{
+		m_Commands.reserve(commandCount);
+	}
+
+	void AudioCommandBuffer::Clear()
+	{
+		m_Commands.clear();
+		m_Plays.clear();
+	}
+
+	size_t AudioCommandBuffer::Size() const
+	{
+		return m_Commands.size();
+	}
+
+	bool AudioCommandBuffer::Empty() const
+	{
+		return m_Commands.empty();
+	}
+
+	AudioCommandBuffer::Command& AudioCommandBuffer::Record(uint64_t entityID, CommandType type)
+	{
+		auto& command = m_Commands.emplace_back();
+
+		command.entityID = entityID;
+		command.sequence = static_cast<uint32_t>(m_Commands.size() - 1);
+		command.type = type;
+
+		return command;
+	}
+
+} // Mix
\ No newline at end of file
@@ -0,0 +1,99 @@
+#pragma once
+
+#include <cstdint>
+#include <optional>
+#include <vector>
+
+#include "MaizeMix/Helper/AudioSpecification.h"
+#include "MaizeMix/AudioClip.h"
+
+namespace Mix {
+
+	/**
+	 * Records audio commands without touching the engine, so systems (or jobs with their own buffer) can fill it cheaply
+	 * The whole buffer is later applied by AudioEngine::Submit in one pass sorted by entity
+	 */
+	class AudioCommandBuffer
+	{
+	public:
+		void PlayAudio(uint64_t entityID, const AudioClip& clip, const AudioSpecification& spec);
+
+		void PlayAudioAt(uint64_t entityID, const AudioClip& clip, const AudioSpecification& spec, uint64_t startTick);
+
+		void PauseAudio(uint64_t entityID);
+
+		void UnpauseAudio(uint64_t entityID);
+
+		void StopAudio(uint64_t entityID);
+
+		void StopAudioAt(uint64_t entityID, uint64_t stopTick);
+
+		void SetAudioLoopState(uint64_t entityID, bool loop);
+
+		void SetAudioMuteState(uint64_t entityID, bool mute);
+
+		void SetAudioVolume(uint64_t entityID, float volume);
+
+		void SetAudioPitch(uint64_t entityID, float pitch);
+
+		void SetAudioPriority(uint64_t entityID, int32_t priority);
+
+		void SetAudioPosition(uint64_t entityID, float x, float y, float depth);
+
+		void SetAudioOffsetTime(uint64_t entityID, float time);
+
+		void Append(const AudioCommandBuffer& other);
+
+		void Reserve(size_t commandCount);
+
+		void Clear();
+
+		size_t Size() const;
+
+		bool Empty() const;
+
+	private:
+		friend class AudioEngine;
+
+		enum class CommandType : uint8_t
+		{
+			Play = 0,
+			Stop,
+			PauseState,
+			LoopState,
+			MuteState,
+			Volume,
+			Pitch,
+			Priority,
+			Position,
+			OffsetTime,
+			StopTick,
+			Count
+		};
+
+		struct Command
+		{
+			uint64_t entityID = 0;
+			uint32_t sequence = 0; // keeps the recorded order for commands of the same entity
+			CommandType type = CommandType::Play;
+			bool flag = false;
+			int32_t integer = 0; // priority, or the index into m_Plays
+			float values[3] = { };
+			uint64_t tick = 0; // scheduled stops
+		};
+
+		struct PlayCommand
+		{
+			AudioClip clip;
+			AudioSpecification spec;
+			std::optional<uint64_t> startTick;
+		};
+
+		Command& Record(uint64_t entityID, CommandType type);
+
+	private:
+		std::vector<Command> m_Commands;
+		std::vector<PlayCommand> m_Plays;
+	};
+
+} // Mix
\ No newline at end of file
@@ -1,222 +1,484 @@
 #include "MaizeMix/AudioEngine.h"
 
-#include "MaizeMix/Helper/AudioClips/SoundReference.h"
+#include "MaizeMix/Helper/AudioClips/StreamedClip.h"
 #include "MaizeMix/Helper/AudioClips/SoundBuffer.h"
 #include "MaizeMix/AudioClip.h"
 
 #include <iostream>
 #include <cmath>
 #include <cassert>
+#include <algorithm>
+#include <utility>
+#include <array>
+#include <chrono>
 
 namespace Mix {
 
+	AudioEngine::AudioEngine(uint32_t soundVoices, uint32_t streamVoices) :
+		m_SoundPool(soundVoices), m_StreamPool(streamVoices), m_CommandQueue(c_CommandQueueCapacity)
+	{
+	}
+
+	AudioEngine::AudioEngine(Backend backend, uint32_t voices) :
+		AudioEngine(backend == Backend::Sources ? SplitSourceVoices(voices, false) : 0, backend == Backend::Sources ? SplitSourceVoices(voices, true) : 0)
+	{
+		m_Backend = backend;
+
+		if (backend != Backend::Sources)
+		{
+			m_Mixer = std::make_unique<Mixer>(voices);
+			m_TickRate = m_Mixer->GetSampleRate();
+		}
+
+		if (backend == Backend::Mixer)
+		{
+			// the offline backend keeps decoding while it mixes, so rendering never depends on how fast the workers are
+			m_Mixer->EnableStreamDecoding(c_DecodeThreadCount);
+			m_MixerStream = std::make_unique<MixerStream>(*m_Mixer);
+
+			// the stream mixes silence while nothing is playing, so it is only started once
+			m_MixerStream->play();
+		}
+	}
+
+	uint32_t AudioEngine::SplitSourceVoices(uint32_t voices, bool stream)
+	{
+		// past this the backend runs out of sources, which the mixer default would go well beyond
+		const uint32_t total = std::min(voices, c_MaxSourceVoices);
+		const uint32_t streams = total * c_DefaultStreamVoices / c_MaxSourceVoices;
+
+		return stream ? streams : total - streams;
+	}
+
+	AudioEngine::~AudioEngine()
+	{
+		StopAudioThread();
+	}
+
+	AudioEngine::Backend AudioEngine::GetBackend() const
+	{
+		return m_Backend;
+	}
+
 	AudioClip AudioEngine::CreateClip(const std::string& filePath, bool stream)
 	{
 		return m_AudioManager.CreateClip(filePath, stream);
 	}
 
+	AudioClip AudioEngine::CreateClip(const std::string& filePath, Clip::LoadType loadType)
+	{
+		return m_AudioManager.CreateClip(filePath, loadType);
+	}
+
+	AudioClip AudioEngine::CreateClipAsync(const std::string& filePath, bool stream)
+	{
+		return m_AudioManager.CreateClipAsync(filePath, stream);
+	}
+
+	AudioClip AudioEngine::CreateClipAsync(const std::string& filePath, Clip::LoadType loadType)
+	{
+		return m_AudioManager.CreateClipAsync(filePath, loadType);
+	}
+
 	void AudioEngine::RemoveClip(AudioClip& clip)
 	{
+		// the rules go with the last reference to the clip, the audio thread may be reading them though
+		// clip ids are never reused so rules left behind can't apply to another clip
+		if (!m_IsAudioThreadRunning && m_AudioManager.GetReferenceCount(clip) == 1) m_ClipPlayback.erase(clip.m_ClipID);
+
 		m_AudioManager.DestroyClip(clip);
 	}
 
-	bool AudioEngine::PlayAudio(uint64_t entityID, const AudioClip& clip, const AudioSpecification& spec)
+	bool AudioEngine::SetStreamHead(const AudioClip& clip, float seconds)
+	{
+		return m_AudioManager.SetStreamHead(clip, seconds);
+	}
+
+	size_t AudioEngine::GetClipMemoryUsage() const
+	{
+		return m_AudioManager.GetMemoryUsage();
+	}
+
+	AudioHandle AudioEngine::PlayAudio(uint64_t entityID, const AudioClip& clip, const AudioSpecification& spec)
+	{
+		return PlayAudio(entityID, clip, spec, std::nullopt);
+	}
+
+	AudioHandle AudioEngine::PlayAudioAt(uint64_t entityID, const AudioClip& clip, const AudioSpecification& spec, uint64_t startTick)
 	{
-		if (HasHitMaxAudioSources()) return false;
+		return PlayAudio(entityID, clip, spec, startTick);
+	}
 
+	AudioHandle AudioEngine::PlayAudio(uint64_t entityID, const AudioClip& clip, const AudioSpecification& spec, std::optional<uint64_t> startTick)
+	{
 		if (const auto handle = clip.m_Handle.lock())
 		{
+			const auto state = handle->GetState();
+
+			if (state == Clip::State::Failed) return RejectPlay(PlayRejection::FailedClip);
+			if (state == Clip::State::Unloaded && m_PendingClipPolicy == PendingClipPolicy::Reject) return RejectPlay(PlayRejection::PendingClip);
+
 			// stop if the entity is current playing
 			StopAudio(entityID);
 
-			if (clip.IsLoadInBackground())
-			{
-				return PlayClip(entityID, static_cast<SoundReference&>(*handle), spec, m_AudioEventQueue, m_CurrentTime.asSeconds());
-			}
+			AudioHandle victim;
 
-			return PlayClip(entityID, static_cast<SoundBuffer&>(*handle), spec, m_AudioEventQueue, m_CurrentTime.asSeconds());
+			if (!ApplyClipRules(clip.m_ClipID, victim)) return {};
+
+			return PlayClip(entityID, clip.m_ClipID, handle, clip.IsLoadInBackground(), spec, startTick, victim);
 		}
 
-		return false;
+		return RejectPlay(PlayRejection::ExpiredClip);
 	}
 
-	bool AudioEngine::PauseAudio(uint64_t entityID)
+	AudioHandle AudioEngine::GetAudioHandle(uint64_t entityID) const
 	{
-		if (!m_CurrentPlayingAudio.contains(entityID)) return false;
-
-		auto& source = m_CurrentPlayingAudio.at(entityID);
-
-		if (!source.IsValid())
+		if (const auto it = m_EntityHandles.find(entityID); it != m_EntityHandles.end())
 		{
-			HandleInvalid(entityID, source.iterator);
-			return false;
+			return it->second;
 		}
 
-		return std::visit([&](auto& emitter)
-		{
-			// pause only if it is playing
-			if (emitter.getStatus() == sf::SoundSource::Playing)
-			{
-				// pause the audio and remove it from the event queue
-				emitter.pause();
-				m_AudioEventQueue.erase(source.iterator);
+		return {};
+	}
 
-				return true;
-			}
+	bool AudioEngine::SetPendingClipPolicy(PendingClipPolicy policy)
+	{
+		if (m_IsAudioThreadRunning) return false;
 
-			return false;
-		}, source.source);
+		m_PendingClipPolicy = policy;
+
+		return true;
 	}
 
-	bool AudioEngine::UnpauseAudio(uint64_t entityID)
+	bool AudioEngine::SetClipPlaybackRules(const AudioClip& clip, const ClipPlaybackRules& rules)
 	{
-		if (!m_CurrentPlayingAudio.contains(entityID)) return false;
+		if (!clip.IsValid() || m_IsAudioThreadRunning) return false;
 
-		auto& source = m_CurrentPlayingAudio.at(entityID);
+		m_ClipPlayback[clip.m_ClipID].rules = rules;
 
-		if (!source.IsValid())
-		{
-			HandleInvalid(entityID, source.iterator);
-			return false;
-		}
+		return true;
+	}
 
-		return std::visit([&](auto& emitter)
-		{
-			// pause only if it is playing
-			if (emitter.getStatus() == sf::SoundSource::Paused)
-			{
-				// pause the audio and remove it from the event queue
-				emitter.play();
+	AudioEngine::BusHandle AudioEngine::CreateBus(BusHandle parent)
+	{
+		if (parent >= m_Buses.size() || m_IsAudioThreadRunning) return c_InvalidBus;
 
-				return RequeueAudioClip(entityID, source.GetDuration(), emitter.getPlayingOffset().asSeconds(), emitter.getLoop(), m_CurrentTime.asSeconds(), source);
-			}
+		Bus& bus = m_Buses.emplace_back();
 
-			return false;
-		}, source.source);
+		bus.parent = parent;
+		m_AreBusesDirty = true;
+
+		return static_cast<BusHandle>(m_Buses.size() - 1);
 	}
 
-	bool AudioEngine::StopAudio(uint64_t entityID)
+	bool AudioEngine::SetBusVolume(BusHandle bus, float volume)
 	{
-		if (!m_CurrentPlayingAudio.contains(entityID)) return false;
+		if (bus >= m_Buses.size() || m_IsAudioThreadRunning) return false;
+
+		m_Buses[bus].volume = std::clamp(volume, 0.0f, 100.0f);
+		m_AreBusesDirty = true;
+
+		return true;
+	}
 
-		auto& source = m_CurrentPlayingAudio.at(entityID);
+	bool AudioEngine::PauseBus(BusHandle bus)
+	{
+		if (bus >= m_Buses.size() || m_IsAudioThreadRunning || m_Buses[bus].isPaused) return false;
 
-		std::visit([&](auto& emitter) { emitter.stop(); }, source.source);
+		m_Buses[bus].isPaused = true;
+		m_AreBusesDirty = true;
 
-		// trigger event handle any outside finished logic
-		if (m_OnAudioFinish) m_OnAudioFinish(source.entity);
+		return true;
+	}
+
+	bool AudioEngine::UnpauseBus(BusHandle bus)
+	{
+		if (bus >= m_Buses.size() || m_IsAudioThreadRunning || !m_Buses[bus].isPaused) return false;
+
+		m_Buses[bus].isPaused = false;
+		m_AreBusesDirty = true;
+
+		return true;
+	}
 
-		HandleInvalid(entityID, source.iterator); // despite the name, it just removes it
+	bool AudioEngine::StopBus(BusHandle bus)
+	{
+		if (bus >= m_Buses.size() || m_IsAudioThreadRunning) return false;
+
+		m_Buses[bus].stopSequence = m_PlaySequence + 1;
+		m_AreBusesDirty = true;
 
 		return true;
 	}
 
-	bool AudioEngine::SetAudioLoopState(uint64_t entityID, bool loop)
+	bool AudioEngine::SetVoiceLimit(uint32_t limit, StealPolicy policy)
 	{
-		if (!m_CurrentPlayingAudio.contains(entityID)) return false;
+		if (m_IsAudioThreadRunning) return false;
+
+		m_VoiceLimit = limit;
+		m_StealPolicy = policy;
+
+		RebuildStealIndex();
+
+		return true;
+	}
+
+	bool AudioEngine::PauseAudio(uint64_t entityID) { return PauseSource(FindSource(entityID)); }
+	bool AudioEngine::PauseAudio(AudioHandle handle) { return PauseSource(FindSource(handle)); }
 
-		auto& source = m_CurrentPlayingAudio.at(entityID);
+	bool AudioEngine::UnpauseAudio(uint64_t entityID) { return UnpauseSource(FindSource(entityID)); }
+	bool AudioEngine::UnpauseAudio(AudioHandle handle) { return UnpauseSource(FindSource(handle)); }
 
-		if (!source.IsValid()) return false;
+	bool AudioEngine::StopAudio(uint64_t entityID) { return StopSource(FindSource(entityID)); }
+	bool AudioEngine::StopAudio(AudioHandle handle) { return StopSource(FindSource(handle)); }
 
-		return std::visit([&](auto& emitter)
+	bool AudioEngine::StopAudioAt(uint64_t entityID, uint64_t stopTick) { return StopSourceAt(FindSource(entityID), stopTick); }
+	bool AudioEngine::StopAudioAt(AudioHandle handle, uint64_t stopTick) { return StopSourceAt(FindSource(handle), stopTick); }
+
+	bool AudioEngine::SetAudioLoopState(uint64_t entityID, bool loop) { return SetSourceLoopState(FindSource(entityID), loop); }
+	bool AudioEngine::SetAudioLoopState(AudioHandle handle, bool loop) { return SetSourceLoopState(FindSource(handle), loop); }
+
+	bool AudioEngine::SetAudioMuteState(uint64_t entityID, bool mute) { return SetSourceMuteState(FindSource(entityID), mute); }
+	bool AudioEngine::SetAudioMuteState(AudioHandle handle, bool mute) { return SetSourceMuteState(FindSource(handle), mute); }
+
+	bool AudioEngine::SetAudioVolume(uint64_t entityID, float volume) { return SetSourceVolume(FindSource(entityID), volume); }
+	bool AudioEngine::SetAudioVolume(AudioHandle handle, float volume) { return SetSourceVolume(FindSource(handle), volume); }
+
+	bool AudioEngine::SetAudioPitch(uint64_t entityID, float pitch) { return SetSourcePitch(FindSource(entityID), pitch); }
+	bool AudioEngine::SetAudioPitch(AudioHandle handle, float pitch) { return SetSourcePitch(FindSource(handle), pitch); }
+
+	bool AudioEngine::SetAudioPriority(uint64_t entityID, int32_t priority) { return SetSourcePriority(FindSource(entityID), priority); }
+	bool AudioEngine::SetAudioPriority(AudioHandle handle, int32_t priority) { return SetSourcePriority(FindSource(handle), priority); }
+
+	bool AudioEngine::SetAudioPosition(uint64_t entityID, float x, float y, float depth) { return SetSourcePosition(FindSource(entityID), x, y, depth); }
+	bool AudioEngine::SetAudioPosition(AudioHandle handle, float x, float y, float depth) { return SetSourcePosition(FindSource(handle), x, y, depth); }
+
+	bool AudioEngine::SetAudioOffsetTime(uint64_t entityID, float time) { return SetSourceOffsetTime(FindSource(entityID), time); }
+	bool AudioEngine::SetAudioOffsetTime(AudioHandle handle, float time) { return SetSourceOffsetTime(FindSource(handle), time); }
+
+	float AudioEngine::GetAudioOffsetTime(uint64_t entityID) { return GetSourceOffsetTime(FindSource(entityID)); }
+	float AudioEngine::GetAudioOffsetTime(AudioHandle handle) { return GetSourceOffsetTime(FindSource(handle)); }
+
+	bool AudioEngine::SyncSource(uint64_t entityID, const AudioSpecification& spec, float& offset) { return SyncSource(FindSource(entityID), spec, offset); }
+	bool AudioEngine::SyncSource(AudioHandle handle, const AudioSpecification& spec, float& offset) { return SyncSource(FindSource(handle), spec, offset); }
+
+	template <typename T, typename Function>
+	size_t AudioEngine::ForEachSource(std::span<const AudioHandle> handles, std::span<T> values, Function&& function)
+	{
+		const size_t count = std::min(handles.size(), values.size());
+		size_t applied = 0;
+
+		for (size_t i = 0; i < count; i++)
 		{
-			if (emitter.getLoop() == loop) return false; // leave function if the same state
-			emitter.setLoop(loop);
+			if (function(FindSource(handles[i]), values[i])) applied++;
+		}
 
-			return RequeueAudioClip(entityID, source.GetDuration(), emitter.getPlayingOffset().asSeconds(), emitter.getLoop(), m_CurrentTime.asSeconds(), source);
-		}, source.source);
+		return applied;
 	}
 
-	bool AudioEngine::SetAudioMuteState(uint64_t entityID, bool mute)
+	std::span<const AudioHandle> AudioEngine::ResolveHandles(std::span<const uint64_t> entities)
 	{
-		if (!m_CurrentPlayingAudio.contains(entityID)) return false;
+		m_ResolvedHandles.clear();
+
+		// entities that aren't playing resolve to an invalid handle
+		for (const uint64_t entityID : entities)
+		{
+			m_ResolvedHandles.push_back(GetAudioHandle(entityID));
+		}
+
+		return m_ResolvedHandles;
+	}
 
-		auto& source = m_CurrentPlayingAudio.at(entityID);
+	size_t AudioEngine::PlayAudio(std::span<const uint64_t> entities, std::span<const AudioClip> clips, std::span<const AudioSpecification> specs)
+	{
+		auto shared = [&](size_t size) { return size == 1 ? entities.size() : std::min(size, entities.size()); };
 
-		if (!source.IsValid()) return false;
+		const size_t count = std::min(shared(clips.size()), shared(specs.size()));
+		size_t played = 0;
 
-		return std::visit([&](auto& emitter)
+		for (size_t i = 0; i < count; i++)
 		{
-			const float volume = mute ? 0.0f : emitter.getVolume();
+			const auto& clip = clips[clips.size() == 1 ? 0 : i];
+			const auto& spec = specs[specs.size() == 1 ? 0 : i];
 
-			source.isMute = mute;
-			emitter.setVolume(volume);
+			if (PlayAudio(entities[i], clip, spec)) played++;
+		}
 
-			return true;
-		}, source.source);
+		return played;
 	}
 
-	bool AudioEngine::SetAudioVolume(uint64_t entityID, float volume)
+	size_t AudioEngine::StopAudio(std::span<const uint64_t> entities) { return StopAudio(ResolveHandles(entities)); }
+	size_t AudioEngine::SetAudioVolumes(std::span<const uint64_t> entities, std::span<const float> volumes) { return SetAudioVolumes(ResolveHandles(entities), volumes); }
+	size_t AudioEngine::SetAudioPitches(std::span<const uint64_t> entities, std::span<const float> pitches) { return SetAudioPitches(ResolveHandles(entities), pitches); }
+	size_t AudioEngine::SetAudioPositions(std::span<const uint64_t> entities, std::span<const sf::Vector3f> positions) { return SetAudioPositions(ResolveHandles(entities), positions); }
+	size_t AudioEngine::GetAudioOffsetTimes(std::span<const uint64_t> entities, std::span<float> offsets) { return GetAudioOffsetTimes(ResolveHandles(entities), offsets); }
+	size_t AudioEngine::SyncSources(std::span<const uint64_t> entities, std::span<const AudioSpecification> specs, std::span<float> offsets) { return SyncSources(ResolveHandles(entities), specs, offsets); }
+
+	size_t AudioEngine::StopAudio(std::span<const AudioHandle> handles)
 	{
-		if (!m_CurrentPlayingAudio.contains(entityID)) return false;
+		size_t stopped = 0;
 
-		auto& source = m_CurrentPlayingAudio.at(entityID);
+		for (const AudioHandle handle : handles)
+		{
+			if (StopSource(FindSource(handle))) stopped++;
+		}
 
-		if (source.isMute) return false;
-		if (!source.IsValid()) return false;
+		return stopped;
+	}
 
-		std::visit([&](auto& emitter) { emitter.setVolume(std::clamp(volume, 0.0f, 100.0f)); }, source.source);
+	size_t AudioEngine::SetAudioVolumes(std::span<const AudioHandle> handles, std::span<const float> volumes)
+	{
+		return ForEachSource(handles, volumes, [this](Source* source, float volume) { return SetSourceVolume(source, volume); });
+	}
 
-		return true;
+	size_t AudioEngine::SetAudioPitches(std::span<const AudioHandle> handles, std::span<const float> pitches)
+	{
+		return ForEachSource(handles, pitches, [this](Source* source, float pitch) { return SetSourcePitch(source, pitch); });
+	}
+
+	size_t AudioEngine::SetAudioPositions(std::span<const AudioHandle> handles, std::span<const sf::Vector3f> positions)
+	{
+		return ForEachSource(handles, positions, [this](Source* source, const sf::Vector3f& position)
+		{
+			return SetSourcePosition(source, position.x, position.y, position.z);
+		});
+	}
+
+	size_t AudioEngine::GetAudioOffsetTimes(std::span<const AudioHandle> handles, std::span<float> offsets)
+	{
+		return ForEachSource(handles, offsets, [this](Source* source, float& offset)
+		{
+			offset = GetSourceOffsetTime(source);
+
+			return source != nullptr;
+		});
 	}
 
-	bool AudioEngine::SetAudioPitch(uint64_t entityID, float pitch)
+	size_t AudioEngine::SyncSources(std::span<const AudioHandle> handles, std::span<const AudioSpecification> specs, std::span<float> offsets)
 	{
-		if (!m_CurrentPlayingAudio.contains(entityID)) return false;
+		const size_t count = std::min({ handles.size(), specs.size(), offsets.size() });
+		size_t synced = 0;
 
-		auto& source = m_CurrentPlayingAudio.at(entityID);
+		for (size_t i = 0; i < count; i++)
+		{
+			if (SyncSource(FindSource(handles[i]), specs[i], offsets[i])) synced++;
+		}
+
+		return synced;
+	}
 
-		if (!source.IsValid()) return false;
+	bool AudioEngine::IsAudioVirtual(uint64_t entityID) const
+	{
+		const auto* source = FindSource(entityID);
 
-		std::visit([&](auto& emitter) { emitter.setPitch(std::max(0.0001f, pitch)); }, source.source);
+		return source != nullptr && source->IsVirtual();
+	}
 
-		return true;
+	bool AudioEngine::IsAudioVirtual(AudioHandle handle) const
+	{
+		const auto* source = FindSource(handle);
+
+		return source != nullptr && source->IsVirtual();
+	}
+
+	uint32_t AudioEngine::GetAudioUnderruns(uint64_t entityID) const
+	{
+		const auto* source = FindSource(entityID);
+
+		return source != nullptr ? GetUnderruns(*source) : 0;
+	}
+
+	uint32_t AudioEngine::GetAudioUnderruns(AudioHandle handle) const
+	{
+		const auto* source = FindSource(handle);
+
+		return source != nullptr ? GetUnderruns(*source) : 0;
+	}
+
+	uint32_t AudioEngine::GetUnderruns(const Source& source) const
+	{
+		// backend streams decode on their own thread, which doesn't report running dry
+		const auto* const* voice = std::get_if<MixerVoice*>(&source.source);
+
+		return voice != nullptr && *voice != nullptr ? (*voice)->getUnderruns() : 0;
 	}
 
-    bool AudioEngine::SetAudioOffsetTime(uint64_t entityID, float time)
-    {
-		if (!m_CurrentPlayingAudio.contains(entityID)) return false;
+	void AudioEngine::Submit(AudioCommandBuffer& commands)
+	{
+		auto& recorded = commands.m_Commands;
 
-		auto& source = m_CurrentPlayingAudio.at(entityID);
+		// group commands by entity while keeping the recorded order inside each group
+		std::sort(recorded.begin(), recorded.end(), [](const auto& lhs, const auto& rhs)
+		{
+			if (lhs.entityID != rhs.entityID) return lhs.entityID < rhs.entityID;
 
-		if (!source.IsValid()) return false;
+			return lhs.sequence < rhs.sequence;
+		});
 
-		return std::visit([&](auto& emitter)
+		for (size_t begin = 0; begin < recorded.size();)
 		{
-			// don't need to update the position if they are "equal"
-			if (std::abs(time - source.previousTimeOffset) < std::numeric_limits<float>::epsilon()) return false;
+			size_t end = begin + 1;
 
-			emitter.setPlayingOffset(sf::seconds(time));
+			while (end < recorded.size() && recorded[end].entityID == recorded[begin].entityID) end++;
 
-			return RequeueAudioClip(entityID, source.GetDuration(), emitter.getPlayingOffset().asSeconds(), emitter.getLoop(), m_CurrentTime.asSeconds(), source);
-		}, source.source);
-    }
+			ApplyCommands(commands, begin, end);
 
-    float AudioEngine::GetAudioOffsetTime(uint64_t entityID)
-    {
-		if (!m_CurrentPlayingAudio.contains(entityID)) return false;
+			begin = end;
+		}
+
+		commands.Clear();
+	}
+
+	bool AudioEngine::Enqueue(AudioCommandBuffer& commands)
+	{
+		if (commands.Empty()) return true;
 
-		auto& source = m_CurrentPlayingAudio.at(entityID);
+		return m_CommandQueue.TryPush(commands);
+	}
 
-		if (!source.IsValid()) return false;
+	void AudioEngine::StartAudioThread(float updateInterval)
+	{
+		if (m_IsAudioThreadRunning.exchange(true)) return;
 
-		return std::visit([&](auto& emitter)
+		m_AudioThread = std::thread([this, updateInterval]()
 		{
-			const float offset = emitter.getPlayingOffset().asSeconds();
+			const auto interval = std::chrono::duration<float>(updateInterval);
+
+			while (m_IsAudioThreadRunning.load(std::memory_order_relaxed))
+			{
+				Update();
 
-			source.previousTimeOffset = offset;
+				std::this_thread::sleep_for(interval);
+			}
+		});
+	}
 
-			return offset;
-		}, source.source);
-    }
+	void AudioEngine::StopAudioThread()
+	{
+		if (!m_IsAudioThreadRunning.exchange(false)) return;
+
+		if (m_AudioThread.joinable()) m_AudioThread.join();
+	}
+
+	bool AudioEngine::IsAudioThreadRunning() const
+	{
+		return m_IsAudioThreadRunning;
+	}
 
-	bool AudioEngine::SetListenerPosition(float x, float y, float depth) const
+	bool AudioEngine::SetListenerPosition(float x, float y, float depth)
 	{
+		// the audio thread owns the voices and the listener they are ranked against
+		if (m_IsAudioThreadRunning) return false;
+
         // causes backend issues if this isn't here, mainly because audio doesn't exist to offset other emitters
-		if (!m_CurrentPlayingAudio.empty())
+		if (!m_CurrentPlayingAudio.Empty())
 		{
-			sf::Listener::setPosition(x, y, depth);
+			// the offline backend never touches the audio device
+			if (m_Backend != Backend::Offline) sf::Listener::setPosition(x, y, depth);
+
+			if (m_Mixer != nullptr) m_Mixer->SetListenerPosition(sf::Vector3f(x, y, depth));
+
+			m_ListenerPosition = sf::Vector3f(x, y, depth);
 
 			return true;
 		}
@@ -226,10 +488,13 @@ namespace Mix {
 
 	bool AudioEngine::SetGlobalVolume(float volume) const
 	{
+		if (m_IsAudioThreadRunning) return false;
+
         // causes backend issues if this isn't here, mainly because audio doesn't exist to offset other emitters
-		if (!m_CurrentPlayingAudio.empty())
+		if (!m_CurrentPlayingAudio.Empty())
 		{
-			sf::Listener::setGlobalVolume(std::clamp(volume, 0.0f, 100.0f));
+			if (m_Backend == Backend::Offline) m_Mixer->SetVolume(std::clamp(volume, 0.0f, 100.0f));
+			else sf::Listener::setGlobalVolume(std::clamp(volume, 0.0f, 100.0f));
 
 			return true;
 		}
@@ -237,81 +502,1493 @@ namespace Mix {
 		return false;
 	}
 
-	void AudioEngine::SetAudioFinishCallback(std::function<void(uint64_t)>&& callback)
+	bool AudioEngine::SetAudioFinishCallback(std::function<void(uint64_t)>&& callback)
 	{
-		m_OnAudioFinish = callback;
-	}
+		// the audio thread may be calling the current one
+		if (m_IsAudioThreadRunning) return false;
 
-	bool AudioEngine::HasHitMaxAudioSources() const
-	{
-		if (m_AudioEventQueue.size() >= c_MaxAudioEmitters)
+		if (!callback)
 		{
+			m_OnAudioFinish = nullptr;
 			return true;
 		}
 
-		return false;
+		m_OnAudioFinish = [callback = std::move(callback)](uint64_t entityID, FinishReason) { callback(entityID); };
+
+		return true;
+	}
+
+	bool AudioEngine::SetAudioFinishCallback(std::function<void(uint64_t, FinishReason)>&& callback)
+	{
+		if (m_IsAudioThreadRunning) return false;
+
+		m_OnAudioFinish = std::move(callback);
+
+		return true;
+	}
+
+	std::span<const AudioEngine::FinishEvent> AudioEngine::GetFinishEvents() const
+	{
+		return m_PublishedFinishEvents;
+	}
+
+	void AudioEngine::NotifyFinish(uint64_t entityID, FinishReason reason)
+	{
+		// the callback is left to Publish, so it never runs in the middle of a call on the engine
+		m_FinishEvents.push_back({ entityID, reason });
+	}
+
+	bool AudioEngine::HasHitMaxAudioSources() const
+	{
+		// any voice played from here on starts out virtual
+		if (m_Mixer != nullptr) return m_Mixer->GetVoices().IsExhausted();
+
+		return m_SoundPool.IsExhausted() && m_StreamPool.IsExhausted();
+	}
+
+	bool AudioEngine::HasExhaustedSoundVoices() const
+	{
+		if (m_Mixer != nullptr) return m_Mixer->GetVoices().IsExhausted();
+
+		return m_SoundPool.IsExhausted();
+	}
+
+	bool AudioEngine::HasExhaustedStreamVoices() const
+	{
+		if (m_Mixer != nullptr) return m_Mixer->GetVoices().IsExhausted();
+
+		return m_StreamPool.IsExhausted();
+	}
+
+	size_t AudioEngine::EmitterCount() const
+	{
+		return m_AudioEventQueue.Size();
 	}
 
-	uint8_t AudioEngine::EmitterCount() const
+	size_t AudioEngine::RealEmitterCount() const
 	{
-		return m_AudioEventQueue.size();
+		const size_t mixerVoices = m_Mixer != nullptr ? m_Mixer->GetVoices().InUse() : 0;
+
+		return m_SoundPool.InUse() + m_StreamPool.InUse() + mixerVoices;
+	}
+
+	size_t AudioEngine::VirtualEmitterCount() const
+	{
+		return m_CurrentPlayingAudio.Size() - RealEmitterCount();
+	}
+
+	AudioStats AudioEngine::GetStats() const
+	{
+		AudioStats stats = m_Stats;
+
+		stats.streamVoices = m_RealStreamVoices;
+		stats.soundVoices = static_cast<uint32_t>(RealEmitterCount()) - m_RealStreamVoices;
+		stats.virtualVoices = static_cast<uint32_t>(VirtualEmitterCount());
+		stats.mixTime = m_Mixer != nullptr ? m_Mixer->GetMixTime() : 0.0f;
+		stats.clipCount = m_AudioManager.GetClipCount();
+		stats.clipMemory = m_AudioManager.GetMemoryUsage();
+		stats.clipLoadTime = m_AudioManager.GetLoadTime();
+
+		return stats;
 	}
 
 	void AudioEngine::Update(float deltaTime)
 	{
-		// update audio system time
-		m_CurrentTime += sf::seconds(deltaTime);
+		// carry the part of a tick that doesn't fit, so frame times never drift from the timeline
+		m_TickRemainder += static_cast<double>(std::max(deltaTime, 0.0f)) * m_TickRate;
 
-		// remove all finished sounds
-		while (!m_AudioEventQueue.empty() && m_CurrentTime.asSeconds() >= m_AudioEventQueue.begin()->stopTime)
-		{
-			const uint64_t entityID = m_AudioEventQueue.begin()->entityID;
+		const auto ticks = static_cast<uint64_t>(std::floor(m_TickRemainder));
 
-			if (m_CurrentPlayingAudio.contains(entityID))
-			{
-				m_CurrentPlayingAudio.erase(entityID);
+		m_TickRemainder -= static_cast<double>(ticks);
 
-				if (m_OnAudioFinish)
-				{
-					m_OnAudioFinish(entityID);
-				}
-			}
+		if (m_Mixer != nullptr) m_MixerFrameOffset = static_cast<int64_t>(m_Mixer->GetMixedFrames()) - static_cast<int64_t>(m_CurrentTick + ticks);
 
-			m_AudioEventQueue.erase(m_AudioEventQueue.begin());
-		}
+		Advance(ticks);
+		Publish();
 	}
 
-	bool AudioEngine::RequeueAudioClip(uint64_t entityID, float duration, float playingOffset, bool isLooping, float currentTime, Source& source)
+	void AudioEngine::Update()
 	{
-		// calculate the remaining play time
-		const float playingTimeLeft = duration - playingOffset;
-		const float stopTime = isLooping ? std::numeric_limits<float>::max() : currentTime + playingTimeLeft;
+		AdvanceToBackend();
+		Publish();
+	}
 
-		// remove existing event to avoid duplicates
-		if (m_AudioEventQueue.contains(*source.iterator)) m_AudioEventQueue.erase(source.iterator);
+	void AudioEngine::AdvanceToBackend()
+	{
+		const uint64_t backendTick = m_Mixer != nullptr
+			? m_Mixer->GetMixedFrames()
+			: static_cast<uint64_t>(m_BackendClock.getElapsedTime().asMicroseconds()) * m_TickRate / 1000000;
 
-		// attempt to reinsert with new stop time
-		const auto [it, successful] = m_AudioEventQueue.emplace(entityID, stopTime);
-		if (successful)
-		{
-			source.iterator = it;
-			return true;
-		}
+		const uint64_t ticks = backendTick - m_BackendTick;
 
-		return false;
+		if (m_Mixer != nullptr) m_MixerFrameOffset = static_cast<int64_t>(backendTick) - static_cast<int64_t>(m_CurrentTick + ticks);
+
+		m_BackendTick = backendTick;
+
+		Advance(ticks);
 	}
 
-	void AudioEngine::HandleInvalid(uint64_t entityID, EventIterator it)
+	uint64_t AudioEngine::GetCurrentTick() const
 	{
-		if (m_AudioEventQueue.contains(*it))
-		{
-			m_AudioEventQueue.erase(it);
-		}
+		return m_CurrentTick;
+	}
 
-		if (m_CurrentPlayingAudio.contains(entityID))
-		{
-			m_CurrentPlayingAudio.erase(entityID);
-		}
+	uint32_t AudioEngine::GetTickRate() const
+	{
+		return m_TickRate;
+	}
+
+	uint64_t AudioEngine::ToMixerFrame(uint64_t tick) const
+	{
+		return static_cast<uint64_t>(std::max<int64_t>(static_cast<int64_t>(tick) + m_MixerFrameOffset, 0));
+	}
+
+	uint64_t AudioEngine::GetScheduleLookahead() const
+	{
+		// backend sources can't be told when to start, so they are started once it is time
+		return m_Mixer != nullptr ? ToTicks(c_ScheduleLookahead) : 0;
+	}
+
+	uint64_t AudioEngine::ToTicks(float seconds) const
+	{
+		return static_cast<uint64_t>(std::llround(static_cast<double>(std::max(seconds, 0.0f)) * m_TickRate));
+	}
+
+	void AudioEngine::Advance(uint64_t ticks)
+	{
+		const sf::Clock clock;
+
+		// update audio system time
+		m_CurrentTick += ticks;
+
+		// apply anything other threads have queued up
+		while (m_CommandQueue.TryPop(m_QueuedCommands))
+		{
+			Submit(m_QueuedCommands);
+		}
+
+		ApplyBuses();
+
+		// remove all finished sounds, the scheduler keeps the earliest stop time on top
+		while (!m_AudioEventQueue.Empty() && m_CurrentTick >= m_AudioEventQueue.Top().stopTime)
+		{
+			const AudioHandle handle = AudioHandle::FromKey(m_AudioEventQueue.Top().id);
+
+			if (auto* source = m_CurrentPlayingAudio.Get(handle))
+			{
+				const uint64_t entityID = source->entity;
+				const bool wasStolen = source->isStolen;
+				const bool wasStopped = source->stopTick <= m_CurrentTick;
+
+				HandleInvalid(*source);
+
+				// a stolen voice has already finished, this is just the end of its fade
+				if (wasStolen) continue;
+
+				if (wasStopped) m_FrameStats.voicesStopped++;
+				else m_FrameStats.voicesFinished++;
+
+				NotifyFinish(entityID, wasStopped ? FinishReason::Stopped : FinishReason::Finished);
+			}
+			else
+			{
+				m_AudioEventQueue.Pop();
+			}
+		}
+
+		// scheduled plays join the ones waiting on their clip, which starts them if it has loaded
+		while (!m_StartQueue.Empty() && m_CurrentTick >= m_StartQueue.Top().stopTime)
+		{
+			const AudioHandle handle = AudioHandle::FromKey(m_StartQueue.Top().id);
+
+			auto* source = m_CurrentPlayingAudio.Get(handle);
+
+			m_StartQueue.Pop();
+			source->startEvent = EventScheduler::c_InvalidHandle;
+
+			// its stop came before the update that would have started it
+			if (source->stopTick <= m_CurrentTick)
+			{
+				StopSource(source);
+				continue;
+			}
+
+			m_PendingSources.push_back(handle);
+		}
+
+		// start anything that was waiting on its clip to load
+		for (size_t i = 0; i < m_PendingSources.size();)
+		{
+			auto* source = m_CurrentPlayingAudio.Get(m_PendingSources[i]);
+			const auto clip = source != nullptr ? source->clip.lock() : nullptr;
+
+			if (clip != nullptr && clip->GetState() == Clip::State::Unloaded)
+			{
+				i++;
+				continue;
+			}
+
+			m_PendingSources[i] = m_PendingSources.back();
+			m_PendingSources.pop_back();
+
+			if (source == nullptr) continue; // stopped while it was waiting
+			if (clip != nullptr && clip->IsLoaded() && StartSource(*source, *clip)) continue;
+
+			// the clip failed to load or was removed, so there is nothing to play
+			const uint64_t entityID = source->entity;
+
+			HandleInvalid(*source);
+			RejectPlay(PlayRejection::FailedClip);
+
+			NotifyFinish(entityID, FinishReason::ClipLost);
+		}
+
+		FadeStolenSources();
+
+		// only rank voices when there are more of them than backend voices
+		if (VirtualEmitterCount() > 0)
+		{
+			if (m_Mixer != nullptr)
+			{
+				RebalanceVoices(m_Mixer->GetVoices(), std::nullopt);
+			}
+			else
+			{
+				RebalanceVoices(m_SoundPool, false);
+				RebalanceVoices(m_StreamPool, true);
+			}
+		}
+
+		if (const auto* decoder = m_Mixer != nullptr ? m_Mixer->GetStreamDecoder() : nullptr)
+		{
+			const uint64_t underruns = decoder->GetUnderruns();
+
+			m_FrameStats.streamUnderruns += static_cast<uint32_t>(underruns - m_StreamUnderruns);
+			m_StreamUnderruns = underruns;
+		}
+
+		// adds up over the blocks of a render
+		m_FrameStats.updateTime += clock.getElapsedTime().asSeconds();
+	}
+
+	void AudioEngine::Publish()
+	{
+		// publish this frame and start counting the next one
+		m_Stats = m_FrameStats;
+		m_FrameStats = AudioStats();
+
+		// both buffers keep their capacity, so this stops allocating once the busiest frame has been seen
+		std::swap(m_FinishEvents, m_PublishedFinishEvents);
+		m_FinishEvents.clear();
+
+		if (!m_OnAudioFinish) return;
+
+		// anything the callback finishes lands in the next batch
+		for (size_t i = 0; i < m_PublishedFinishEvents.size(); i++)
+		{
+			m_OnAudioFinish(m_PublishedFinishEvents[i].entity, m_PublishedFinishEvents[i].reason);
+		}
+	}
+
+	bool AudioEngine::Render(sf::Int16* output, size_t frames)
+	{
+		// the audio thread would be updating the engine against the wall clock at the same time
+		if (m_Backend != Backend::Offline || m_IsAudioThreadRunning) return false;
+
+		RenderBlocks(output, frames);
+		Publish();
+
+		return true;
+	}
+
+	void AudioEngine::RenderBlocks(sf::Int16* output, size_t frames)
+	{
+		for (size_t done = 0; done < frames; done += c_RenderBlockFrames)
+		{
+			const size_t count = std::min(c_RenderBlockFrames, frames - done);
+
+			m_Mixer->Mix(output + done * Mixer::c_ChannelCount, count);
+
+			AdvanceToBackend();
+		}
+	}
+
+	bool AudioEngine::RenderToFile(const std::string& filePath, float seconds)
+	{
+		if (m_Backend != Backend::Offline || m_IsAudioThreadRunning) return false;
+
+		sf::OutputSoundFile file;
+
+		if (!file.openFromFile(filePath, m_Mixer->GetSampleRate(), Mixer::c_ChannelCount)) return false;
+
+		const auto frames = static_cast<size_t>(std::max(seconds, 0.0f) * static_cast<float>(m_Mixer->GetSampleRate()));
+		std::vector<sf::Int16> block(c_RenderBlockFrames * Mixer::c_ChannelCount);
+
+		for (size_t done = 0; done < frames; done += c_RenderBlockFrames)
+		{
+			const size_t count = std::min(c_RenderBlockFrames, frames - done);
+
+			RenderBlocks(block.data(), count);
+			file.write(block.data(), count * Mixer::c_ChannelCount);
+		}
+
+		Publish();
+
+		return true;
+	}
+
+	uint32_t AudioEngine::GetOutputSampleRate() const
+	{
+		return m_Mixer != nullptr ? m_Mixer->GetSampleRate() : 0;
+	}
+
+	AudioEngine::Source* AudioEngine::FindSource(uint64_t entityID)
+	{
+		if (const auto it = m_EntityHandles.find(entityID); it != m_EntityHandles.end())
+		{
+			return m_CurrentPlayingAudio.Get(it->second);
+		}
+
+		return nullptr;
+	}
+
+	AudioEngine::Source* AudioEngine::FindSource(AudioHandle handle)
+	{
+		auto* source = m_CurrentPlayingAudio.Get(handle);
+
+		// a stolen voice only lingers to fade out
+		return source != nullptr && !source->isStolen ? source : nullptr;
+	}
+
+	const AudioEngine::Source* AudioEngine::FindSource(uint64_t entityID) const
+	{
+		if (const auto it = m_EntityHandles.find(entityID); it != m_EntityHandles.end())
+		{
+			return m_CurrentPlayingAudio.Get(it->second);
+		}
+
+		return nullptr;
+	}
+
+	const AudioEngine::Source* AudioEngine::FindSource(AudioHandle handle) const
+	{
+		const auto* source = m_CurrentPlayingAudio.Get(handle);
+
+		return source != nullptr && !source->isStolen ? source : nullptr;
+	}
+
+	bool AudioEngine::PauseSource(Source* source)
+	{
+		if (source == nullptr) return false;
+
+		if (!source->IsValid())
+		{
+			HandleInvalid(*source);
+			m_FrameStats.voicesFinished++;
+			return false;
+		}
+
+		// pause only if it is playing
+		if (source->isHandPaused) return false;
+
+		// a voice held by its bus is paused by the engine, not by its backend status
+		if (!source->isPaused && !source->IsVirtual())
+		{
+			const bool isPlaying = std::visit([](auto* emitter) { return emitter->getStatus() == sf::SoundSource::Playing; }, source->source);
+
+			if (!isPlaying) return false;
+		}
+
+		source->isHandPaused = true;
+		ApplyPause(*source);
+
+		return true;
+	}
+
+	bool AudioEngine::UnpauseSource(Source* source)
+	{
+		if (source == nullptr) return false;
+
+		if (!source->IsValid())
+		{
+			HandleInvalid(*source);
+			m_FrameStats.voicesFinished++;
+			return false;
+		}
+
+		// un-pause only if it is paused, it still waits on its bus if that is paused
+		if (!source->isHandPaused) return false;
+
+		source->isHandPaused = false;
+		ApplyPause(*source);
+
+		return true;
+	}
+
+	void AudioEngine::ApplyPause(Source& source)
+	{
+		const bool pause = source.isHandPaused || source.isBusPaused;
+
+		if (source.isPaused == pause) return;
+
+		if (pause)
+		{
+			// pause the audio and remove it from the event queue
+			SyncAnchor(source);
+			source.isPaused = true;
+
+			if (!source.IsVirtual()) std::visit([](auto* emitter) { emitter->pause(); }, source.source);
+
+			if (m_AudioEventQueue.IsScheduled(source.event)) m_AudioEventQueue.Cancel(source.event);
+			source.event = EventScheduler::c_InvalidHandle;
+		}
+		else
+		{
+			source.isPaused = false;
+			source.anchorTick = m_CurrentTick;
+
+			if (!source.IsVirtual()) std::visit([](auto* emitter) { emitter->play(); }, source.source);
+
+			RequeueAudioClip(source);
+		}
+
+		UpdateStealKey(source);
+	}
+
+	bool AudioEngine::StopSource(Source* source)
+	{
+		if (source == nullptr) return false;
+
+		if (!source->IsVirtual()) std::visit([](auto* emitter) { emitter->stop(); }, source->source);
+
+		// trigger event handle any outside finished logic
+		NotifyFinish(source->entity, FinishReason::Stopped);
+
+		HandleInvalid(*source); // despite the name, it just removes it
+		m_FrameStats.voicesStopped++;
+
+		return true;
+	}
+
+	bool AudioEngine::StopSourceAt(Source* source, uint64_t stopTick)
+	{
+		if (source == nullptr) return false;
+
+		if (stopTick <= m_CurrentTick) return StopSource(source);
+
+		source->stopTick = stopTick;
+
+		if (auto** voice = std::get_if<MixerVoice*>(&source->source); voice && *voice) (*voice)->setStopFrame(ToMixerFrame(stopTick));
+
+		// the deadline becomes whichever comes first, the stop or the end of the clip
+		return RequeueAudioClip(*source);
+	}
+
+	bool AudioEngine::SetSourceLoopState(Source* source, bool loop)
+	{
+		if (source == nullptr) return false;
+		if (!source->IsValid()) return false;
+		if (source->isLooping == loop) return false; // leave function if the same state
+
+		SyncAnchor(*source);
+		source->isLooping = loop;
+
+		if (!source->IsVirtual()) std::visit([&](auto* emitter) { emitter->setLoop(loop); }, source->source);
+
+		return RequeueAudioClip(*source);
+	}
+
+	bool AudioEngine::SetSourceMuteState(Source* source, bool mute)
+	{
+		if (source == nullptr) return false;
+		if (!source->IsValid()) return false;
+
+		source->isMute = mute;
+
+		if (!source->IsVirtual()) std::visit([&](auto* emitter) { emitter->setVolume(GetEmitterVolume(*source)); }, source->source);
+
+		UpdateStealKey(*source);
+
+		return true;
+	}
+
+	bool AudioEngine::SetSourceVolume(Source* source, float volume)
+	{
+		if (source == nullptr) return false;
+		if (source->isMute) return false;
+		if (!source->IsValid()) return false;
+
+		source->volume = std::clamp(volume, 0.0f, 100.0f);
+
+		if (!source->IsVirtual()) std::visit([&](auto* emitter) { emitter->setVolume(GetEmitterVolume(*source)); }, source->source);
+
+		UpdateStealKey(*source);
+
+		return true;
+	}
+
+	bool AudioEngine::SetSourceBus(Source* source, BusHandle bus)
+	{
+		if (source == nullptr) return false;
+		if (bus >= m_Buses.size()) return false;
+		if (!source->IsValid()) return false;
+
+		RemoveFromBus(*source);
+
+		source->bus = bus;
+		source->busSlot = static_cast<uint32_t>(m_Buses[bus].voices.size());
+		m_Buses[bus].voices.push_back(source->handle);
+
+		// the new bus may be paused differently, or not yet folded if it was just changed, which the next update takes care of
+		source->isBusPaused = m_Buses[bus].isEffectivelyPaused;
+		ApplyPause(*source);
+
+		if (auto** voice = std::get_if<MixerVoice*>(&source->source); voice && *voice) (*voice)->setBus(bus);
+		if (!source->IsVirtual()) std::visit([&](auto* emitter) { emitter->setVolume(GetEmitterVolume(*source)); }, source->source);
+
+		UpdateStealKey(*source);
+
+		return true;
+	}
+
+	bool AudioEngine::SetSourcePitch(Source* source, float pitch)
+	{
+		if (source == nullptr) return false;
+		if (!source->IsValid()) return false;
+
+		// the pitch changes how fast the clip is played through, so it also moves the stop time
+		SyncAnchor(*source);
+		source->pitch = std::max(0.0001f, pitch);
+
+		if (!source->IsVirtual()) std::visit([&](auto* emitter) { emitter->setPitch(source->pitch); }, source->source);
+
+		return RequeueAudioClip(*source);
+	}
+
+	bool AudioEngine::SetSourcePriority(Source* source, int32_t priority)
+	{
+		if (source == nullptr) return false;
+		if (!source->IsValid()) return false;
+
+		source->priority = priority;
+
+		UpdateStealKey(*source);
+
+		return true;
+	}
+
+	bool AudioEngine::SetSourcePosition(Source* source, float x, float y, float depth)
+	{
+		if (source == nullptr) return false;
+		if (!source->IsValid()) return false;
+
+		source->position = sf::Vector3f(x, y, depth);
+
+		if (!source->IsVirtual()) std::visit([&](auto* emitter) { emitter->setPosition(source->position); }, source->source);
+
+		UpdateStealKey(*source);
+
+		return true;
+	}
+
+	bool AudioEngine::SetSourceOffsetTime(Source* source, float time)
+	{
+		if (source == nullptr) return false;
+		if (!source->IsValid()) return false;
+
+		// don't need to update the position if they are "equal"
+		if (std::abs(time - source->previousTimeOffset) < std::numeric_limits<float>::epsilon()) return false;
+
+		if (!source->IsVirtual()) std::visit([&](auto* emitter) { emitter->setPlayingOffset(sf::seconds(time)); }, source->source);
+
+		source->anchorOffset = time;
+		source->anchorTick = m_CurrentTick;
+
+		return RequeueAudioClip(*source);
+	}
+
+	float AudioEngine::GetSourceOffsetTime(Source* source)
+	{
+		if (source == nullptr) return false;
+		if (!source->IsValid()) return false;
+
+		const float offset = GetPlayingOffset(*source);
+
+		source->previousTimeOffset = offset;
+
+		return offset;
+	}
+
+	bool AudioEngine::SyncSource(Source* source, const AudioSpecification& spec, float& offset)
+	{
+		if (source == nullptr) return false;
+		if (!source->IsValid()) return false;
+
+		const float volume = std::clamp(spec.volume, 0.0f, 100.0f);
+		const float pitch = std::max(0.0001f, spec.pitch);
+
+		if (source->isLooping != spec.loop) SetSourceLoopState(source, spec.loop);
+		if (source->priority != spec.priority) SetSourcePriority(source, spec.priority);
+		if (source->bus != spec.bus) SetSourceBus(source, spec.bus);
+		if (source->pitch != pitch) SetSourcePitch(source, pitch);
+
+		// the volume is kept while muted, so whichever of the two is audible is applied at once
+		if (source->isMute != spec.mute || source->volume != volume)
+		{
+			source->volume = volume;
+			SetSourceMuteState(source, spec.mute);
+		}
+
+		SetSourceOffsetTime(source, offset); // only seeks if the offset moved since it was last read
+		offset = GetSourceOffsetTime(source);
+
+		return true;
+	}
+
+	void AudioEngine::ApplyCommands(const AudioCommandBuffer& commands, size_t begin, size_t end)
+	{
+		using CommandType = AudioCommandBuffer::CommandType;
+
+		const auto& recorded = commands.m_Commands;
+		const uint64_t entityID = recorded[begin].entityID;
+
+		// only the latest command of each kind since the last play or stop has any effect
+		std::array<size_t, static_cast<size_t>(CommandType::Count)> latest;
+		size_t reset = end;
+
+		latest.fill(end);
+
+		for (size_t i = begin; i < end; i++)
+		{
+			const CommandType type = recorded[i].type;
+
+			if (type == CommandType::Play || type == CommandType::Stop)
+			{
+				latest.fill(end);
+				reset = i;
+			}
+			else
+			{
+				latest[static_cast<size_t>(type)] = i;
+			}
+		}
+
+		const auto take = [&](CommandType type) -> const AudioCommandBuffer::Command*
+		{
+			const size_t index = std::exchange(latest[static_cast<size_t>(type)], end);
+
+			return index != end ? &recorded[index] : nullptr;
+		};
+
+		Source* source = nullptr;
+
+		if (reset != end && recorded[reset].type == CommandType::Stop)
+		{
+			StopAudio(entityID);
+			return;
+		}
+
+		if (reset != end)
+		{
+			const auto& play = commands.m_Plays[recorded[reset].integer];
+			auto spec = play.spec;
+
+			// fold the settings into the specification so the voice starts out with them
+			if (const auto* command = take(CommandType::LoopState)) spec.loop = command->flag;
+			if (const auto* command = take(CommandType::MuteState)) spec.mute = command->flag;
+			if (const auto* command = take(CommandType::Volume)) spec.volume = command->values[0];
+			if (const auto* command = take(CommandType::Pitch)) spec.pitch = command->values[0];
+			if (const auto* command = take(CommandType::Priority)) spec.priority = command->integer;
+
+			source = FindSource(PlayAudio(entityID, play.clip, spec, play.startTick));
+		}
+		else
+		{
+			source = FindSource(entityID);
+		}
+
+		if (source == nullptr) return;
+
+		if (!source->IsValid())
+		{
+			HandleInvalid(*source);
+			m_FrameStats.voicesFinished++;
+			return;
+		}
+
+		const auto* stopAt = take(CommandType::StopTick);
+
+		// apply whatever is left in the order it was recorded
+		std::sort(latest.begin(), latest.end());
+
+		for (const size_t index : latest)
+		{
+			if (index == end) break;
+
+			const auto& command = recorded[index];
+
+			switch (command.type)
+			{
+				case CommandType::PauseState:
+					if (command.flag) PauseSource(source);
+					else UnpauseSource(source);
+					break;
+				case CommandType::LoopState: SetSourceLoopState(source, command.flag); break;
+				case CommandType::MuteState: SetSourceMuteState(source, command.flag); break;
+				case CommandType::Volume: SetSourceVolume(source, command.values[0]); break;
+				case CommandType::Pitch: SetSourcePitch(source, command.values[0]); break;
+				case CommandType::Priority: SetSourcePriority(source, command.integer); break;
+				case CommandType::Position: SetSourcePosition(source, command.values[0], command.values[1], command.values[2]); break;
+				case CommandType::OffsetTime: SetSourceOffsetTime(source, command.values[0]); break;
+				default: break;
+			}
+		}
+
+		// last, since a stop that is already due removes the source
+		if (stopAt != nullptr) StopSourceAt(source, stopAt->tick);
+	}
+
+	bool AudioEngine::RequeueAudioClip(Source& source)
+	{
+		// paused audio is not on the queue until it is resumed
+		if (source.isPaused || source.isPending) return true;
+
+		// calculate the remaining play time
+		const float playingTimeLeft = (source.GetDuration() - source.GetOffset(m_CurrentTick, m_TickRate)) / source.pitch;
+		const uint64_t startTick = std::max(m_CurrentTick, source.anchorTick);
+		const uint64_t stopTime = std::min(source.isLooping ? c_NoDeadline : startTick + ToTicks(playingTimeLeft), source.stopTick);
+
+		// move the existing event rather than reinserting it
+		if (m_AudioEventQueue.IsScheduled(source.event))
+		{
+			m_AudioEventQueue.Reschedule(source.event, stopTime);
+		}
+		else
+		{
+			source.event = m_AudioEventQueue.Schedule(source.handle.ToKey(), stopTime);
+		}
+
+		return true;
+	}
+
+	void AudioEngine::HandleInvalid(Source& source)
+	{
+		if (m_AudioEventQueue.IsScheduled(source.event))
+		{
+			m_AudioEventQueue.Cancel(source.event);
+		}
+
+		if (m_StealIndex.IsScheduled(source.stealEntry))
+		{
+			m_StealIndex.Cancel(source.stealEntry);
+		}
+
+		if (m_StartQueue.IsScheduled(source.startEvent))
+		{
+			m_StartQueue.Cancel(source.startEvent);
+		}
+
+		ReleaseVoice(source);
+
+		// a stolen voice gave its entity up when it was stolen, which may be playing something else by now
+		if (source.isStolen)
+		{
+			m_StolenCount--;
+		}
+		else
+		{
+			m_EntityHandles.erase(source.entity);
+			ReleaseClipInstance(source);
+		}
+
+		RemoveFromBus(source);
+		m_CurrentPlayingAudio.Erase(source.handle); // invalidates source
+	}
+
+	void AudioEngine::ReleaseVoice(Source& source)
+	{
+		// reset the voice so it doesn't keep a clip alive or look valid when handed out again
+		if (auto* sound = std::get_if<sf::Sound*>(&source.source); sound && *sound)
+		{
+			(*sound)->resetBuffer();
+			m_SoundPool.Release(*sound);
+		}
+		else if (auto* music = std::get_if<Music*>(&source.source); music && *music)
+		{
+			(*music)->resetReference();
+			m_StreamPool.Release(*music);
+		}
+		else if (auto* voice = std::get_if<MixerVoice*>(&source.source); voice && *voice)
+		{
+			(*voice)->resetBuffer();
+			m_Mixer->GetVoices().Release(*voice);
+		}
+
+		if (!source.IsVirtual() && source.isStream) m_RealStreamVoices--;
+
+		source.source = static_cast<sf::Sound*>(nullptr);
+	}
+
+	float AudioEngine::GetPlayingOffset(const Source& source) const
+	{
+		// the backend knows best while the voice is real
+		if (!source.IsVirtual())
+		{
+			return std::visit([](auto* emitter) { return emitter->getPlayingOffset().asSeconds(); }, source.source);
+		}
+
+		return source.GetOffset(m_CurrentTick, m_TickRate);
+	}
+
+	void AudioEngine::SyncAnchor(Source& source)
+	{
+		source.anchorOffset = GetPlayingOffset(source);
+		source.anchorTick = m_CurrentTick;
+	}
+
+	float AudioEngine::GetListenerDistance(const Source& source) const
+	{
+		return GetDistance(source.position, m_ListenerPosition);
+	}
+
+	float AudioEngine::GetDistance(const sf::Vector3f& lhs, const sf::Vector3f& rhs)
+	{
+		const float dx = lhs.x - rhs.x;
+		const float dy = lhs.y - rhs.y;
+		const float dz = lhs.z - rhs.z;
+
+		return std::sqrt(dx * dx + dy * dy + dz * dz);
+	}
+
+	float AudioEngine::GetAudibility(const Source& source) const
+	{
+		return GetAudibility(source, m_ListenerPosition);
+	}
+
+	float AudioEngine::GetAudibility(const Source& source, const sf::Vector3f& listener) const
+	{
+		if (source.isPaused || source.isMute) return 0.0f;
+
+		// matches the default inverse distance attenuation of the backend
+		return source.volume * m_Buses[source.bus].gain / std::max(GetDistance(source.position, listener), 1.0f);
+	}
+
+	float AudioEngine::GetEmitterVolume(const Source& source) const
+	{
+		// the mixer applies the bus gain itself while mixing
+		const float gain = m_Mixer != nullptr ? 1.0f : m_Buses[source.bus].gain;
+
+		return source.isMute ? 0.0f : source.volume * gain;
+	}
+
+	void AudioEngine::ApplyBuses()
+	{
+		if (!m_AreBusesDirty) return;
+
+		m_AreBusesDirty = false;
+
+		bool isUnpausing = false;
+
+		if (m_Mixer != nullptr) m_MixerBuses.resize(m_Buses.size());
+
+		// parents come first, so each bus only has to be combined with its parent
+		for (size_t i = 0; i < m_Buses.size(); i++)
+		{
+			Bus& bus = m_Buses[i];
+			const Bus* parent = i > 0 ? &m_Buses[bus.parent] : nullptr;
+
+			const float gain = bus.volume / 100.0f * (parent != nullptr ? parent->gain : 1.0f);
+			const bool isPaused = bus.isPaused || (parent != nullptr && parent->isEffectivelyPaused);
+			const uint64_t stopSequence = std::max(bus.stopSequence, parent != nullptr ? parent->effectiveStopSequence : 0);
+
+			// the mixer takes care of the volume, but the voices still have to keep track of their own time
+			// and the steal keys of quietest stealing depend on it
+			const bool isGainVisited = gain != bus.gain && (m_Mixer == nullptr || (m_StealPolicy == StealPolicy::Quietest && !m_StealIndex.Empty()));
+
+			bus.hasVoiceChanges = isPaused != bus.isEffectivelyPaused || stopSequence != bus.effectiveStopSequence || isGainVisited;
+
+			if (m_Mixer != nullptr)
+			{
+				// a bus being unpaused is held until all of its voices are playing again, so they come back on the same block
+				m_MixerBuses[i] = { gain, isPaused || bus.isEffectivelyPaused };
+				isUnpausing |= bus.isEffectivelyPaused && !isPaused;
+			}
+
+			bus.gain = gain;
+			bus.isEffectivelyPaused = isPaused;
+			bus.effectiveStopSequence = stopSequence;
+		}
+
+		if (m_Mixer != nullptr) m_Mixer->SetBuses(m_MixerBuses);
+
+		for (Bus& bus : m_Buses)
+		{
+			if (!bus.hasVoiceChanges) continue;
+
+			for (const AudioHandle handle : bus.voices)
+			{
+				auto& source = *m_CurrentPlayingAudio.Get(handle);
+
+				if (source.isStolen || !source.IsValid()) continue;
+
+				// stopping removes the source, which would shuffle the ones still to come
+				if (source.sequence < bus.effectiveStopSequence)
+				{
+					m_InvalidSources.push_back(source.handle);
+					continue;
+				}
+
+				if (source.isBusPaused != bus.isEffectivelyPaused)
+				{
+					source.isBusPaused = bus.isEffectivelyPaused;
+					ApplyPause(source);
+				}
+
+				if (!source.IsVirtual()) std::visit([&](auto* emitter) { emitter->setVolume(GetEmitterVolume(source)); }, source.source);
+
+				// audibility includes the bus volume
+				if (m_StealPolicy == StealPolicy::Quietest) UpdateStealKey(source);
+			}
+		}
+
+		if (isUnpausing)
+		{
+			for (size_t i = 0; i < m_Buses.size(); i++)
+			{
+				m_MixerBuses[i].isPaused = m_Buses[i].isEffectivelyPaused;
+			}
+
+			m_Mixer->SetBuses(m_MixerBuses);
+		}
+
+		for (const AudioHandle handle : m_InvalidSources)
+		{
+			StopSource(m_CurrentPlayingAudio.Get(handle));
+		}
+
+		m_InvalidSources.clear();
+	}
+
+	void AudioEngine::RemoveFromBus(const Source& source)
+	{
+		auto& voices = m_Buses[source.bus].voices;
+
+		// the last voice takes its place
+		m_CurrentPlayingAudio.Get(voices.back())->busSlot = source.busSlot;
+		voices[source.busSlot] = voices.back();
+		voices.pop_back();
+	}
+
+	double AudioEngine::GetStealKey(const Source& source, const sf::Vector3f& listener) const
+	{
+		// lower keys are stolen first
+		switch (m_StealPolicy)
+		{
+			case StealPolicy::Oldest: return static_cast<double>(source.sequence);
+			case StealPolicy::Quietest:
+			{
+				// in log space a listener move shifts every key by a bounded amount, see GetStealKeyError
+				const float audibility = GetAudibility(source, listener);
+
+				return audibility > 0.0f ? std::log(static_cast<double>(audibility)) : -std::numeric_limits<double>::infinity();
+			}
+			case StealPolicy::LowestPriority: return source.priority;
+			case StealPolicy::Furthest: return -GetDistance(source.position, listener);
+			default: return 0.0;
+		}
+	}
+
+	double AudioEngine::GetStealKeyError() const
+	{
+		// how far any indexed key can be from the key against the current listener
+		const double moved = GetDistance(m_ListenerPosition, m_StealListener);
+
+		switch (m_StealPolicy)
+		{
+			case StealPolicy::Quietest: return std::log1p(moved); // distances are clamped to at least 1
+			case StealPolicy::Furthest: return moved;
+			default: return 0.0;
+		}
+	}
+
+	void AudioEngine::UpdateStealKey(Source& source)
+	{
+		if (m_StealIndex.IsScheduled(source.stealEntry)) m_StealIndex.Reschedule(source.stealEntry, GetStealKey(source, m_StealListener));
+	}
+
+	void AudioEngine::RebuildStealIndex()
+	{
+		m_StealIndex = RankScheduler();
+		m_StealListener = m_ListenerPosition;
+
+		const bool isIndexed = m_VoiceLimit > 0 && m_StealPolicy != StealPolicy::None;
+
+		for (auto& source : m_CurrentPlayingAudio)
+		{
+			source.stealEntry = isIndexed && !source.isStolen ? m_StealIndex.Schedule(source.handle.ToKey(), GetStealKey(source, m_StealListener)) : EventScheduler::c_InvalidHandle;
+		}
+	}
+
+	bool AudioEngine::StealVoice(const Source& incoming)
+	{
+		if (m_StealPolicy == StealPolicy::None) return false;
+		if (m_StealIndex.Empty()) return false;
+
+		AudioHandle victim = AudioHandle::FromKey(m_StealIndex.Top().id);
+		double victimKey = m_StealIndex.Top().stopTime;
+
+		// keys are indexed against where the listener was, so anything within twice the error of the top could be the
+		// real lowest, those few are taken out and ranked against the current listener
+		// silent voices have the lowest key wherever the listener is
+		const double error = GetStealKeyError();
+
+		if (error > 0.0 && !std::isinf(victimKey))
+		{
+			const double bound = victimKey + error * 2.0;
+
+			m_StealCandidates.clear();
+			victimKey = std::numeric_limits<double>::infinity();
+
+			while (!m_StealIndex.Empty() && m_StealIndex.Top().stopTime <= bound && m_StealCandidates.size() < c_StealCandidateLimit)
+			{
+				m_StealCandidates.push_back(m_StealIndex.Top());
+				m_StealIndex.Pop();
+			}
+
+			const bool isExhausted = !m_StealIndex.Empty() && m_StealIndex.Top().stopTime <= bound;
+
+			for (const auto& candidate : m_StealCandidates)
+			{
+				auto& source = *m_CurrentPlayingAudio.Get(AudioHandle::FromKey(candidate.id));
+				const double key = GetStealKey(source, m_ListenerPosition);
+
+				source.stealEntry = m_StealIndex.Schedule(candidate.id, candidate.stopTime);
+
+				if (key < victimKey)
+				{
+					victim = source.handle;
+					victimKey = key;
+				}
+			}
+
+			// the listener moved so far that too many keys overlap, index them against where it is now
+			if (isExhausted)
+			{
+				RebuildStealIndex();
+
+				victim = AudioHandle::FromKey(m_StealIndex.Top().id);
+				victimKey = m_StealIndex.Top().stopTime;
+			}
+		}
+
+		// even the lowest ranked voice outranks the new one
+		if (victimKey > GetStealKey(incoming, m_ListenerPosition)) return false;
+
+		StealSource(*m_CurrentPlayingAudio.Get(victim));
+
+		return true;
+	}
+
+	void AudioEngine::StealSource(Source& source)
+	{
+		const uint64_t entityID = source.entity;
+
+		m_FrameStats.voicesStolen++;
+
+		// the entity is free to play something else straight away
+		if (m_StealIndex.IsScheduled(source.stealEntry)) m_StealIndex.Cancel(source.stealEntry);
+		m_EntityHandles.erase(entityID);
+		ReleaseClipInstance(source);
+
+		source.isStolen = true;
+		m_StolenCount++;
+
+		// only something that can be heard needs to fade
+		if (source.IsVirtual() || source.isPaused || source.isPending)
+		{
+			HandleInvalid(source);
+		}
+		else
+		{
+			source.fadeVolume = GetEmitterVolume(source);
+			source.fadeEnd = m_CurrentTick + ToTicks(c_StealFadeTime);
+
+			if (m_AudioEventQueue.IsScheduled(source.event)) m_AudioEventQueue.Reschedule(source.event, source.fadeEnd);
+			else source.event = m_AudioEventQueue.Schedule(source.handle.ToKey(), source.fadeEnd);
+
+			m_StolenSources.push_back(source.handle);
+		}
+
+		NotifyFinish(entityID, FinishReason::Stolen);
+	}
+
+	bool AudioEngine::ApplyClipRules(size_t clipID, AudioHandle& victim)
+	{
+		const auto it = m_ClipPlayback.find(clipID);
+
+		if (it == m_ClipPlayback.end()) return true;
+
+		auto& playback = it->second;
+		const auto& rules = playback.rules;
+		const bool isRetrigger = playback.lastTrigger.has_value() && m_CurrentTick - *playback.lastTrigger < ToTicks(rules.retriggerInterval);
+		const bool isFull = rules.maxInstances > 0 && playback.instances.size() >= rules.maxInstances;
+
+		// the trigger itself is only counted once PlayClip registers the instance
+		if (!isRetrigger && !isFull) return true;
+
+		// only stolen once the play can't be rejected for anything else
+		if (rules.policy == ClipPlaybackRules::LimitPolicy::StealOldest && !isRetrigger)
+		{
+			victim = playback.instances.front();
+
+			return true;
+		}
+
+		// make the newest instance louder rather than stacking another copy on top of it
+		if (rules.policy == ClipPlaybackRules::LimitPolicy::BoostExisting && !playback.instances.empty())
+		{
+			auto* newest = m_CurrentPlayingAudio.Get(playback.instances.back());
+
+			// the volume is kept while muted, so the boost is still there once it is unmuted
+			newest->volume = std::clamp(newest->volume + rules.boostVolume, 0.0f, 100.0f);
+			SetSourceMuteState(newest, newest->isMute);
+		}
+
+		RejectPlay(isRetrigger ? PlayRejection::ClipRetrigger : PlayRejection::ClipLimit);
+
+		return false;
+	}
+
+	void AudioEngine::ReleaseClipInstance(const Source& source)
+	{
+		if (m_ClipPlayback.empty()) return;
+
+		const auto it = m_ClipPlayback.find(source.clipID);
+
+		if (it == m_ClipPlayback.end()) return;
+
+		auto& instances = it->second.instances;
+
+		if (const auto instance = std::find(instances.begin(), instances.end(), source.handle); instance != instances.end())
+		{
+			instances.erase(instance);
+		}
+	}
+
+	void AudioEngine::FadeStolenSources()
+	{
+		const auto fadeTicks = static_cast<float>(ToTicks(c_StealFadeTime));
+
+		for (size_t i = 0; i < m_StolenSources.size();)
+		{
+			auto* source = m_CurrentPlayingAudio.Get(m_StolenSources[i]);
+
+			// done fading
+			if (source == nullptr)
+			{
+				m_StolenSources[i] = m_StolenSources.back();
+				m_StolenSources.pop_back();
+				continue;
+			}
+
+			const uint64_t ticksLeft = source->fadeEnd > m_CurrentTick ? source->fadeEnd - m_CurrentTick : 0;
+			const float fade = std::clamp(static_cast<float>(ticksLeft) / fadeTicks, 0.0f, 1.0f);
+
+			if (!source->IsVirtual()) std::visit([&](auto* emitter) { emitter->setVolume(source->fadeVolume * fade); }, source->source);
+
+			i++;
+		}
+	}
+
+	template <typename T>
+	void AudioEngine::RebalanceVoices(VoicePool<T>& pool, std::optional<bool> stream)
+	{
+		m_RankedSources.clear();
+
+		bool hasVirtual = false;
+
+		for (auto& source : m_CurrentPlayingAudio)
+		{
+			if ((stream && source.isStream != *stream) || source.isPending) continue;
+
+			m_RankedSources.push_back(&source);
+			hasVirtual |= source.IsVirtual();
+		}
+
+		if (!hasVirtual) return;
+
+		// only the most important voices need to be separated from the rest, not fully sorted
+		const size_t budget = std::min(pool.Capacity(), m_RankedSources.size());
+		const auto middle = m_RankedSources.begin() + static_cast<std::ptrdiff_t>(budget);
+
+		// margin is how much louder lhs has to be before it counts as the more important voice
+		const auto outranks = [this](const Source* lhs, const Source* rhs, float margin)
+		{
+			// a stolen voice keeps its backend voice until it has faded out
+			if (lhs->isStolen != rhs->isStolen) return lhs->isStolen;
+
+			// playing voices always outrank paused ones
+			if (lhs->isPaused != rhs->isPaused) return rhs->isPaused;
+			if (lhs->priority != rhs->priority) return lhs->priority > rhs->priority;
+
+			return GetAudibility(*lhs) > GetAudibility(*rhs) * margin;
+		};
+
+		const auto ranks = [&outranks](const Source* lhs, const Source* rhs)
+		{
+			if (outranks(lhs, rhs, 1.0f)) return true;
+			if (outranks(rhs, lhs, 1.0f)) return false;
+
+			// on a tie the voice that is already real keeps its place
+			return !lhs->IsVirtual() && rhs->IsVirtual();
+		};
+
+		std::nth_element(m_RankedSources.begin(), middle, m_RankedSources.end(), ranks);
+
+		m_PromotedSources.clear();
+		m_DemotedSources.clear();
+
+		for (size_t i = 0; i < m_RankedSources.size(); i++)
+		{
+			const Source& source = *m_RankedSources[i];
+
+			if (i < budget && source.IsVirtual() && !source.isPaused && !source.isStolen) m_PromotedSources.push_back(i);
+			else if (i >= budget && !source.IsVirtual()) m_DemotedSources.push_back(i);
+		}
+
+		// pair the weakest newcomers with the strongest voices they would replace, a swap only goes ahead if it is
+		// clearly better so voices that are close don't trade places every update
+		std::sort(m_PromotedSources.begin(), m_PromotedSources.end(), [&](size_t lhs, size_t rhs) { return ranks(m_RankedSources[rhs], m_RankedSources[lhs]); });
+		std::sort(m_DemotedSources.begin(), m_DemotedSources.end(), [&](size_t lhs, size_t rhs) { return ranks(m_RankedSources[lhs], m_RankedSources[rhs]); });
+
+		for (size_t i = 0; i < std::min(m_PromotedSources.size(), m_DemotedSources.size()); i++)
+		{
+			Source*& promoted = m_RankedSources[m_PromotedSources[i]];
+			Source*& demoted = m_RankedSources[m_DemotedSources[i]];
+
+			// the rest are stronger newcomers against weaker voices
+			if (outranks(promoted, demoted, c_RebalanceHysteresis)) break;
+
+			std::swap(promoted, demoted);
+		}
+
+		// free up backend voices from everything that lost its place first
+		for (auto it = middle; it != m_RankedSources.end(); ++it)
+		{
+			if (!(*it)->IsVirtual()) UnbindVoice(**it);
+		}
+
+		for (auto it = m_RankedSources.begin(); it != middle; ++it)
+		{
+			Source& source = **it;
+
+			if (!source.IsVirtual() || source.isPaused || source.isStolen) continue;
+
+			// removing it here would shuffle the sources still being ranked
+			if (AcquireVoice(source) && !BindVoice(source)) m_InvalidSources.push_back(source.handle);
+		}
+
+		// the clip can no longer be played, so treat it as finished
+		for (const AudioHandle handle : m_InvalidSources)
+		{
+			auto& source = *m_CurrentPlayingAudio.Get(handle);
+			const uint64_t entityID = source.entity;
+
+			HandleInvalid(source);
+			m_FrameStats.voicesFinished++;
+
+			NotifyFinish(entityID, FinishReason::ClipLost);
+		}
+
+		m_InvalidSources.clear();
+	}
+
+	AudioHandle AudioEngine::PlayClip(uint64_t entityID, size_t clipID, const std::shared_ptr<Clip>& clip, bool stream, const AudioSpecification& specification, std::optional<uint64_t> startTick, AudioHandle victim)
+	{
+		const auto [entity, successful] = m_EntityHandles.try_emplace(entityID);
+
+		if (!successful) return RejectPlay(PlayRejection::DuplicateEntity);
+
+		const AudioHandle handle = m_CurrentPlayingAudio.Emplace(entityID);
+		auto* source = m_CurrentPlayingAudio.Get(handle);
+
+		entity->second = handle;
+
+		source->handle = handle;
+		source->clipID = clipID;
+		source->clip = clip;
+		source->isStream = stream;
+		source->isMute = specification.mute;
+		source->isLooping = specification.loop;
+		source->priority = specification.priority;
+		source->volume = std::clamp(specification.volume, 0.0f, 100.0f);
+		source->pitch = std::max(0.0001f, specification.pitch);
+		source->sequence = ++m_PlaySequence;
+		source->bus = specification.bus < m_Buses.size() ? specification.bus : c_MasterBus;
+		source->busSlot = static_cast<uint32_t>(m_Buses[source->bus].voices.size());
+		source->isBusPaused = m_Buses[source->bus].isEffectivelyPaused; // joining a paused bus, nothing has played yet to pause
+		source->isPaused = source->isBusPaused;
+		source->startTick = startTick;
+
+		m_Buses[source->bus].voices.push_back(handle);
+
+		if (m_VoiceLimit > 0)
+		{
+			// the instance the clip rules give up already makes room
+			const size_t freed = m_CurrentPlayingAudio.Get(victim) != nullptr ? 1 : 0;
+
+			// make room for the new voice, unless everything playing outranks it
+			if (m_CurrentPlayingAudio.Size() - m_StolenCount - freed > m_VoiceLimit && !StealVoice(*source))
+			{
+				HandleInvalid(*source);
+				return RejectPlay(PlayRejection::VoiceLimit);
+			}
+
+			// removing the victim can move the new source into its slot
+			source = m_CurrentPlayingAudio.Get(handle);
+
+			if (m_StealPolicy != StealPolicy::None) source->stealEntry = m_StealIndex.Schedule(handle.ToKey(), GetStealKey(*source, m_StealListener));
+		}
+
+		if (const auto it = m_ClipPlayback.find(clipID); it != m_ClipPlayback.end())
+		{
+			const auto& rules = it->second.rules;
+
+			// only tracked when something needs to find the oldest or newest instance
+			if (rules.maxInstances > 0 || rules.policy == ClipPlaybackRules::LimitPolicy::BoostExisting) it->second.instances.push_back(handle);
+
+			// a play rejected before this point doesn't start the retrigger interval
+			it->second.lastTrigger = m_CurrentTick;
+		}
+
+		// hold on to it until it is close enough to its start to need a voice
+		if (startTick.has_value() && *startTick > m_CurrentTick + GetScheduleLookahead())
+		{
+			source->isPending = true;
+			source->startEvent = m_StartQueue.Schedule(handle.ToKey(), *startTick - GetScheduleLookahead());
+		}
+		// hold on to it until the clip has loaded
+		else if (!clip->IsLoaded())
+		{
+			source->isPending = true;
+			m_PendingSources.push_back(handle);
+		}
+		else if (!StartSource(*source, *clip))
+		{
+			HandleInvalid(*source);
+			return RejectPlay(PlayRejection::BackendFailure);
+		}
+
+		// the play went through, so the oldest instance of the clip gives way to it
+		if (auto* oldest = m_CurrentPlayingAudio.Get(victim); oldest != nullptr && !oldest->isStolen) StealSource(*oldest);
+
+		return handle;
+	}
+
+	bool AudioEngine::StartSource(Source& source, const Clip& clip)
+	{
+		source.isPending = false;
+		source.duration = clip.GetDuration().asSeconds();
+		source.anchorTick = source.startTick.value_or(m_CurrentTick);
+
+		m_FrameStats.voicesStarted++;
+
+		// paused before it could start, it stays virtual until it is unpaused
+		if (source.isPaused) return true;
+
+		RequeueAudioClip(source);
+
+		// every play is accepted, it is left virtual until a backend voice frees up
+		if (AcquireVoice(source) && !BindVoice(source)) return false;
+
+		return true;
+	}
+
+	bool AudioEngine::AcquireVoice(Source& source)
+	{
+		if (m_Mixer != nullptr)
+		{
+			if (auto* voice = m_Mixer->GetVoices().Acquire()) source.source = voice;
+		}
+		else if (source.isStream)
+		{
+			if (auto* voice = m_StreamPool.Acquire()) source.source = voice;
+		}
+		else
+		{
+			if (auto* voice = m_SoundPool.Acquire()) source.source = voice;
+		}
+
+		if (source.IsVirtual()) return false;
+
+		if (source.isStream) m_RealStreamVoices++;
+
+		return true;
+	}
+
+	AudioHandle AudioEngine::RejectPlay(PlayRejection reason)
+	{
+		m_FrameStats.rejectedPlays[static_cast<size_t>(reason)]++;
+
+		return {};
+	}
+
+	bool AudioEngine::BindVoice(Source& source)
+	{
+		const auto handle = source.clip.lock();
+
+		if (handle == nullptr) return false;
+
+		const float offset = source.GetOffset(m_CurrentTick, m_TickRate);
+
+		if (auto** sound = std::get_if<sf::Sound*>(&source.source); sound && *sound)
+		{
+			(*sound)->setBuffer(static_cast<const SoundBuffer&>(*handle).GetBuffer());
+		}
+		else if (auto** music = std::get_if<Music*>(&source.source); music && *music)
+		{
+			if (!(*music)->setSoundReference(static_cast<const StreamedClip&>(*handle))) return false;
+		}
+		else if (auto** voice = std::get_if<MixerVoice*>(&source.source); voice && *voice)
+		{
+			if (!source.isStream) (*voice)->setBuffer(std::static_pointer_cast<const SoundBuffer>(handle));
+			else if (!(*voice)->setSoundReference(std::static_pointer_cast<const StreamedClip>(handle))) return false;
+
+			// a scheduled play is handed its voice early and waits in the mix for its exact frame
+			if (source.anchorTick > m_CurrentTick) (*voice)->setStartFrame(ToMixerFrame(source.anchorTick));
+			if (source.stopTick != c_NoDeadline) (*voice)->setStopFrame(ToMixerFrame(source.stopTick));
+
+			(*voice)->setBus(source.bus);
+		}
+
+		// resume from where the voice would be had it been audible the whole time
+		std::visit([&](auto* emitter)
+		{
+			emitter->setVolume(GetEmitterVolume(source));
+			emitter->setPitch(source.pitch);
+			emitter->setLoop(source.isLooping);
+			emitter->setPosition(source.position);
+			if (offset > 0.0f) emitter->setPlayingOffset(sf::seconds(offset));
+			emitter->play();
+		}, source.source);
+
+		if (source.anchorTick <= m_CurrentTick)
+		{
+			source.anchorOffset = offset;
+			source.anchorTick = m_CurrentTick;
+		}
+
+		return true;
+	}
+
+	void AudioEngine::UnbindVoice(Source& source)
+	{
+		// remember where the voice got to so it can carry on virtually
+		SyncAnchor(source);
+
+		std::visit([](auto* emitter) { emitter->stop(); }, source.source);
+
+		ReleaseVoice(source);
 	}
 
 } // Mix
\ No newline at end of file
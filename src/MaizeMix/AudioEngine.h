@@ -2,172 +2,569 @@
 
 #include <SFML/Audio.hpp>
 
+#include <unordered_map>
 #include <functional>
+#include <thread>
+#include <atomic>
 #include <limits>
+#include <cmath>
 #include <variant>
+#include <optional>
 #include <memory>
-#include <set>
+#include <vector>
+#include <span>
 
-#include "MaizeMix/Helper/AudioClips/SoundReference.h"
+#include "MaizeMix/Helper/AudioClips/StreamedClip.h"
 #include "MaizeMix/Helper/AudioClips/SoundBuffer.h"
 #include "MaizeMix/Helper/AudioSpecification.h"
+#include "MaizeMix/Helper/AudioStats.h"
+#include "MaizeMix/Helper/EventScheduler.h"
+#include "MaizeMix/Helper/CommandQueue.h"
 #include "MaizeMix/Helper/AudioManager.h"
+#include "MaizeMix/Helper/VoicePool.h"
+#include "MaizeMix/Helper/SlotMap.h"
+#include "MaizeMix/Helper/MixerStream.h"
+#include "MaizeMix/Helper/Mixer.h"
 #include "MaizeMix/Helper/Music.h"
+#include "MaizeMix/AudioCommandBuffer.h"
 
 namespace Mix {
 
 	class AudioClip;
 	class AudioFinishCallback;
 
+	using AudioHandle = SlotHandle;
+
 	class AudioEngine
 	{
 	struct Source;
-	struct AudioEventData;
 
 	public:
+		/**
+		 * Sources plays every voice on its own backend source (sf::Sound / Music)
+		 * Mixer mixes every voice in software and plays the result through a single backend stream
+		 * Offline mixes like Mixer but never opens an audio device, the output is pulled through Render instead
+		 */
+		enum class Backend { Sources = 0, Mixer, Offline };
+
+		explicit AudioEngine(uint32_t soundVoices = c_DefaultSoundVoices, uint32_t streamVoices = c_DefaultStreamVoices);
+		explicit AudioEngine(Backend backend, uint32_t voices = c_DefaultMixerVoices); // for sources voices are capped to the backend limit and split like the defaults
+		~AudioEngine();
+
+		Backend GetBackend() const;
+
+		enum class PendingClipPolicy { Reject = 0, Queue };
+
+		// which voice gives way once the voice limit is reached, None rejects the new play instead
+		enum class StealPolicy : uint8_t { None = 0, Oldest, Quietest, LowestPriority, Furthest };
+
+		// why the finish callback was called
+		enum class FinishReason : uint8_t { Finished = 0, Stopped, Stolen, ClipLost };
+
+		struct FinishEvent
+		{
+			uint64_t entity = 0;
+			FinishReason reason = FinishReason::Finished;
+		};
+
+		using BusHandle = uint32_t;
+		static constexpr BusHandle c_MasterBus = 0;
+		static constexpr BusHandle c_InvalidBus = std::numeric_limits<BusHandle>::max();
+
 		AudioClip CreateClip(const std::string& filePath, bool stream);
 
+		AudioClip CreateClip(const std::string& filePath, Clip::LoadType loadType);
+
+		AudioClip CreateClipAsync(const std::string& filePath, bool stream);
+
+		AudioClip CreateClipAsync(const std::string& filePath, Clip::LoadType loadType);
+
 		void RemoveClip(AudioClip& clip);
 
-		bool PlayAudio(uint64_t entityID, const AudioClip& clip, const AudioSpecification& spec);
+		/**
+		 * Keeps the first seconds of a loaded streamed clip decoded in memory, 0 frees them again
+		 * Voices started from then on play the head right away while the decoder catches up behind it
+		 */
+		bool SetStreamHead(const AudioClip& clip, float seconds);
+
+		size_t GetClipMemoryUsage() const;
+
+		AudioHandle PlayAudio(uint64_t entityID, const AudioClip& clip, const AudioSpecification& spec);
+
+		/**
+		 * Plays on startTick of the engine timeline (GetCurrentTick) instead of right away, the entity owns it from the call on
+		 * The mixer backends hand it a voice shortly before and start it on that exact frame, the sources backend
+		 * starts it on the first Update past it and skips ahead by however late that was
+		 */
+		AudioHandle PlayAudioAt(uint64_t entityID, const AudioClip& clip, const AudioSpecification& spec, uint64_t startTick);
+
+		AudioHandle GetAudioHandle(uint64_t entityID) const;
+
+		bool SetPendingClipPolicy(PendingClipPolicy policy);
+
+		/**
+		 * Caps how many voices can play at once, real and virtual, 0 for no limit
+		 * A play past the limit steals the voice the policy ranks lowest, unless that voice still outranks the new one
+		 * Stolen voices are faded out over a few milliseconds and finish with FinishReason::Stolen
+		 */
+		bool SetVoiceLimit(uint32_t limit, StealPolicy policy = StealPolicy::Quietest);
+
+		/**
+		 * Limits how many instances of the clip play at once and how quickly it can be restarted
+		 * Plays that break the rules are rejected (after boosting the newest instance with BoostExisting),
+		 * or steal the oldest instance when there are too many
+		 */
+		bool SetClipPlaybackRules(const AudioClip& clip, const ClipPlaybackRules& rules);
+
+		/**
+		 * Buses group voices, their volume, pause and stop also apply to every bus below them
+		 * The calls only mark the bus, the next Update folds every bus in O(buses) and then only visits the voices of buses
+		 * whose pause or stop changed, or whose volume changed on the sources backend
+		 * The mixer backends apply bus volume and pause while mixing, so a volume change never visits a voice there
+		 */
+		BusHandle CreateBus(BusHandle parent = c_MasterBus);
+
+		bool SetBusVolume(BusHandle bus, float volume);
+
+		bool PauseBus(BusHandle bus);
+
+		bool UnpauseBus(BusHandle bus);
+
+		bool StopBus(BusHandle bus); // only voices started before the call are stopped
 
 		bool PauseAudio(uint64_t entityID);
+		bool PauseAudio(AudioHandle handle);
 
 		bool UnpauseAudio(uint64_t entityID);
+		bool UnpauseAudio(AudioHandle handle);
 
 		bool StopAudio(uint64_t entityID);
+		bool StopAudio(AudioHandle handle);
+
+		// stops on stopTick, on that exact frame for the mixer backends, and finishes with FinishReason::Stopped
+		bool StopAudioAt(uint64_t entityID, uint64_t stopTick);
+		bool StopAudioAt(AudioHandle handle, uint64_t stopTick);
 
 		bool SetAudioLoopState(uint64_t entityID, bool loop);
+		bool SetAudioLoopState(AudioHandle handle, bool loop);
 
 		bool SetAudioMuteState(uint64_t entityID, bool mute);
+		bool SetAudioMuteState(AudioHandle handle, bool mute);
 
 		bool SetAudioVolume(uint64_t entityID, float volume);
+		bool SetAudioVolume(AudioHandle handle, float volume);
 
 		bool SetAudioPitch(uint64_t entityID, float pitch);
+		bool SetAudioPitch(AudioHandle handle, float pitch);
+
+		bool SetAudioPriority(uint64_t entityID, int32_t priority);
+		bool SetAudioPriority(AudioHandle handle, int32_t priority);
+
+		bool SetAudioPosition(uint64_t entityID, float x, float y, float depth);
+		bool SetAudioPosition(AudioHandle handle, float x, float y, float depth);
 
         bool SetAudioOffsetTime(uint64_t entityID, float time);
+        bool SetAudioOffsetTime(AudioHandle handle, float time);
 
 		float GetAudioOffsetTime(uint64_t entityID);
-
-		bool SetListenerPosition(float x, float y, float depth) const;
+		float GetAudioOffsetTime(AudioHandle handle);
+
+		bool IsAudioVirtual(uint64_t entityID) const;
+		bool IsAudioVirtual(AudioHandle handle) const;
+
+		// times a streamed voice of the mixer backend ran out of decoded audio, since it was last given a voice
+		uint32_t GetAudioUnderruns(uint64_t entityID) const;
+		uint32_t GetAudioUnderruns(AudioHandle handle) const;
+
+		/**
+		 * Brings a playing voice in line with a whole component in one lookup, instead of a setter per field
+		 * Only fields that differ from the voice touch the backend or the event queue, offset is only sought to
+		 * if it changed since the last sync and is always written back with the current playing offset
+		 * A different bus moves the voice over, taking on its volume and pause, an invalid bus is ignored
+		 */
+		bool SyncSource(uint64_t entityID, const AudioSpecification& spec, float& offset);
+		bool SyncSource(AudioHandle handle, const AudioSpecification& spec, float& offset);
+
+		/**
+		 * Bulk versions for component columns, element i of every span belongs to entities[i]
+		 * Only as many entities as the shortest span are processed, and each returns how many of them it applied to
+		 * The handle versions skip the entity lookup, the entity versions look every entity up once before applying anything
+		 */
+		size_t PlayAudio(std::span<const uint64_t> entities, std::span<const AudioClip> clips, std::span<const AudioSpecification> specs); // a single clip or spec is shared by every entity
+		size_t StopAudio(std::span<const uint64_t> entities);
+		size_t SetAudioVolumes(std::span<const uint64_t> entities, std::span<const float> volumes);
+		size_t SetAudioPitches(std::span<const uint64_t> entities, std::span<const float> pitches);
+		size_t SetAudioPositions(std::span<const uint64_t> entities, std::span<const sf::Vector3f> positions);
+		size_t GetAudioOffsetTimes(std::span<const uint64_t> entities, std::span<float> offsets); // 0 for entities that aren't playing
+		size_t SyncSources(std::span<const uint64_t> entities, std::span<const AudioSpecification> specs, std::span<float> offsets);
+
+		size_t StopAudio(std::span<const AudioHandle> handles);
+		size_t SetAudioVolumes(std::span<const AudioHandle> handles, std::span<const float> volumes);
+		size_t SetAudioPitches(std::span<const AudioHandle> handles, std::span<const float> pitches);
+		size_t SetAudioPositions(std::span<const AudioHandle> handles, std::span<const sf::Vector3f> positions);
+		size_t GetAudioOffsetTimes(std::span<const AudioHandle> handles, std::span<float> offsets);
+		size_t SyncSources(std::span<const AudioHandle> handles, std::span<const AudioSpecification> specs, std::span<float> offsets);
+
+		void Submit(AudioCommandBuffer& commands);
+
+		/**
+		 * Thread-safe alternative to Submit, the commands are applied at the start of the next Update
+		 * On success the buffer is swapped for an empty one, returns false without blocking if the queue is full
+		 */
+		bool Enqueue(AudioCommandBuffer& commands);
+
+		/**
+		 * Runs Update on a dedicated thread against the backend clock, after which the engine must only be fed through Enqueue
+		 * and the finish callback is called from that thread
+		 * The listener, global volume, bus, voice limit, pending clip, clip rule and callback setters are rejected while it runs
+		 */
+		void StartAudioThread(float updateInterval = 0.01f);
+
+		void StopAudioThread();
+
+		bool IsAudioThreadRunning() const;
+
+		bool SetListenerPosition(float x, float y, float depth);
 
 		bool SetGlobalVolume(float volume) const;
 
-		void SetAudioFinishCallback(std::function<void(uint64_t)>&& callback);
+		// called by Update (or Render) for every finish event it publishes, stops and steals between updates included
+		bool SetAudioFinishCallback(std::function<void(uint64_t)>&& callback);
+		bool SetAudioFinishCallback(std::function<void(uint64_t, FinishReason)>&& callback);
+
+		/**
+		 * Every voice that finished up to the last Update, in the order they finished, including stops made between updates
+		 * The span stays valid until the next Update, so with the audio thread running use the callback instead
+		 */
+		std::span<const FinishEvent> GetFinishEvents() const;
 
 		bool HasHitMaxAudioSources() const;
 
-		uint8_t EmitterCount() const;
+		bool HasExhaustedSoundVoices() const;
+
+		bool HasExhaustedStreamVoices() const;
+
+		size_t EmitterCount() const;
+
+		size_t RealEmitterCount() const;
+
+		size_t VirtualEmitterCount() const;
+
+		/**
+		 * Counters are from the last Update, voice counts and clip totals are read when called
+		 * Must be called from the thread that runs Update
+		 */
+		AudioStats GetStats() const;
 
 		void Update(float deltaTime);
 
+		/**
+		 * Advances by however far the backend got since the last call, the frames the mixer has mixed
+		 * or the wall clock for the sources backend, so the caller's frame time can't drift from the audio
+		 */
+		void Update();
+
+		// the engine timeline, a 64 bit count of ticks at the output sample rate so it never loses precision
+		uint64_t GetCurrentTick() const;
+
+		uint32_t GetTickRate() const;
+
+		/**
+		 * Offline backend only, mixes the next frames into output as interleaved stereo and advances the
+		 * engine by the time they cover, as fast as they can be mixed
+		 * The engine advances after every block instead of being fed wall clock time, so the output only depends on what was played
+		 * Stats and finish events cover the whole call, as if it was a single Update
+		 */
+		bool Render(sf::Int16* output, size_t frames);
+
+		// renders the next seconds into a wav file
+		bool RenderToFile(const std::string& filePath, float seconds);
+
+		uint32_t GetOutputSampleRate() const;
+
 	private:
-		using EventIterator = std::set<AudioEventData>::iterator;
+		using EventHandle = EventScheduler::Handle;
 
+		/**
+		 * A logical voice, it always tracks its own playback position and is only bound to a
+		 * backend voice while it ranks among the most important voices of its kind
+		 */
 		struct Source
 		{
-			std::variant<sf::Sound, Music> source;
+			std::variant<sf::Sound*, Music*, MixerVoice*> source; // borrowed from the engine voice pools, null while virtual
+			std::weak_ptr<Clip> clip;
 
 			uint64_t entity = 0;
-			EventIterator iterator;
-
+			uint64_t sequence = 0; // order the voices were played in
+			size_t clipID = 0;
+			BusHandle bus = c_MasterBus;
+			uint32_t busSlot = 0; // where it is in the voices of its bus
+			AudioHandle handle;
+			EventHandle event = EventScheduler::c_InvalidHandle; // invalid while paused
+			EventHandle stealEntry = EventScheduler::c_InvalidHandle; // only set while there is a voice limit
+			EventHandle startEvent = EventScheduler::c_InvalidHandle; // only set while a scheduled play waits for its start
+
+			bool isStream = false;
 			bool isMute = false;
+			bool isLooping = false;
+			bool isPaused = false;
+			bool isPending = false; // waiting on its clip to finish loading
+			bool isStolen = false; // fading out, it no longer belongs to its entity
+			bool isHandPaused = false; // through PauseAudio
+			bool isBusPaused = false; // held by its bus, isPaused is set if either is
+			int32_t priority = 0;
+			float volume = 0;
+			float pitch = 1;
+			float duration = 0;
+			sf::Vector3f position;
+
+			float fadeVolume = 0; // volume the fade out started from
+			uint64_t fadeEnd = 0;
+
+			std::optional<uint64_t> startTick; // only for scheduled plays
+			uint64_t stopTick = c_NoDeadline;
+
 			float previousTimeOffset = 0;
+			float anchorOffset = 0; // playing offset at anchorTick
+			uint64_t anchorTick = 0;
 
-			Source(EventIterator event, uint64_t entity) : entity(entity), iterator(event) { }
+			explicit Source(uint64_t entity) : entity(entity) { }
 
 			bool IsValid() const
 			{
-				if (const auto* sound = std::get_if<sf::Sound>(&source)) return sound->getBuffer() != nullptr;
-				if (const auto* music = std::get_if<Music>(&source)) return music->getReference() != nullptr;
-
-				return false;
+				return !clip.expired();
 			}
 
-			float GetDuration() const
+			bool IsVirtual() const
 			{
-				if (const auto* sound = std::get_if<sf::Sound>(&source)) return sound->getBuffer()->getDuration().asSeconds();
-				if (const auto* music = std::get_if<Music>(&source)) return music->getReference()->GetDuration().asSeconds();
-
-				return 0.0f;
+				return std::visit([](const auto* emitter) { return emitter == nullptr; }, source);
 			}
-		};
 
-		struct AudioEventData
-		{
-			const uint64_t entityID = 0;
-			const float stopTime = 0;
-
-			AudioEventData() = default;
-			AudioEventData(uint64_t entityID, float stopTime)
-				: entityID(entityID), stopTime(stopTime)
+			float GetDuration() const
 			{
+				return duration;
 			}
 
-			bool operator<(const AudioEventData& other) const
+			float GetOffset(uint64_t currentTick, uint32_t tickRate) const
 			{
-				if (entityID == other.entityID)
-				{
-					return stopTime < other.stopTime;
-				}
+				const double elapsed = currentTick > anchorTick ? static_cast<double>(currentTick - anchorTick) / tickRate : 0.0; // scheduled plays anchor ahead
+				const float offset = isPaused || isPending ? anchorOffset : anchorOffset + static_cast<float>(elapsed) * pitch;
 
-				return entityID < other.entityID;
+				if (isLooping && duration > 0.0f) return std::fmod(offset, duration);
+
+				return std::min(offset, duration);
 			}
 		};
 
 	private:
-		bool RequeueAudioClip(uint64_t entityID, float duration, float playingOffset, bool isLooping, float currentTime, Source& source);
+		Source* FindSource(uint64_t entityID);
+		Source* FindSource(AudioHandle handle);
+		const Source* FindSource(uint64_t entityID) const;
+		const Source* FindSource(AudioHandle handle) const;
+
+		bool PauseSource(Source* source);
+		bool UnpauseSource(Source* source);
+		bool StopSource(Source* source);
+		void ApplyPause(Source& source); // brings isPaused in line with the hand and bus pause
+		bool SetSourceLoopState(Source* source, bool loop);
+		bool SetSourceMuteState(Source* source, bool mute);
+		bool SetSourceVolume(Source* source, float volume);
+		bool SetSourcePitch(Source* source, float pitch);
+		bool SetSourcePriority(Source* source, int32_t priority);
+		bool SetSourceBus(Source* source, BusHandle bus);
+		bool SetSourcePosition(Source* source, float x, float y, float depth);
+		bool SetSourceOffsetTime(Source* source, float time);
+		float GetSourceOffsetTime(Source* source);
+		bool SyncSource(Source* source, const AudioSpecification& spec, float& offset);
+
+		// calls function with the source of every handle and its value, counting how many it returned true for
+		template <typename T, typename Function>
+		size_t ForEachSource(std::span<const AudioHandle> handles, std::span<T> values, Function&& function);
 
-		void HandleInvalid(uint64_t entityID, EventIterator it);
+		// the span is valid until the next call
+		std::span<const AudioHandle> ResolveHandles(std::span<const uint64_t> entities);
 
+		void ApplyCommands(const AudioCommandBuffer& commands, size_t begin, size_t end);
+
+		bool RequeueAudioClip(Source& source);
+
+		void HandleInvalid(Source& source);
+
+		void ReleaseVoice(Source& source);
+
+		float GetPlayingOffset(const Source& source) const;
+
+		void SyncAnchor(Source& source);
+
+		void Advance(uint64_t ticks); // the stats and finish events pile up until Publish
+
+		void AdvanceToBackend();
+
+		void Publish();
+
+		void RenderBlocks(sf::Int16* output, size_t frames);
+
+		bool StopSourceAt(Source* source, uint64_t stopTick);
+
+		uint64_t ToMixerFrame(uint64_t tick) const;
+
+		uint64_t GetScheduleLookahead() const;
+
+		uint64_t ToTicks(float seconds) const;
+
+		float GetListenerDistance(const Source& source) const;
+
+		static float GetDistance(const sf::Vector3f& lhs, const sf::Vector3f& rhs);
+
+		float GetAudibility(const Source& source) const;
+		float GetAudibility(const Source& source, const sf::Vector3f& listener) const;
+
+		float GetEmitterVolume(const Source& source) const;
+
+		uint32_t GetUnderruns(const Source& source) const;
+
+		void NotifyFinish(uint64_t entityID, FinishReason reason);
+
+		void ApplyBuses();
+
+		void RemoveFromBus(const Source& source);
+
+		double GetStealKey(const Source& source, const sf::Vector3f& listener) const;
+
+		double GetStealKeyError() const;
+
+		void UpdateStealKey(Source& source);
+
+		void RebuildStealIndex();
+
+		bool StealVoice(const Source& incoming);
+
+		void StealSource(Source& source);
+
+		void FadeStolenSources();
+
+		// victim is set to the instance to steal once the play is accepted
+		bool ApplyClipRules(size_t clipID, AudioHandle& victim);
+
+		void ReleaseClipInstance(const Source& source);
+
+		// ranks every source against the pool if stream isn't set
 		template <typename T>
-		bool PlayClip(uint64_t entityID, const T& clip, const AudioSpecification& specification, std::set<AudioEventData>& event, float currentTime)
-		{
-			const float stopTime = specification.loop ? std::numeric_limits<float>::max() : currentTime + clip.GetDuration().asSeconds();
-			const auto [it, successful] = event.emplace(entityID, stopTime);
+		void RebalanceVoices(VoicePool<T>& pool, std::optional<bool> stream);
 
-			if (!successful) return false; // duplicate id
+		bool BindVoice(Source& source);
 
-			m_CurrentPlayingAudio.try_emplace(entityID, it, entityID);
-			auto& soundVariant = m_CurrentPlayingAudio.at(entityID).source;
+		void UnbindVoice(Source& source);
 
-			// set up audio source and specific settings
-			if constexpr (std::is_same_v<T, SoundBuffer>)
-			{
-				soundVariant.emplace<sf::Sound>();
-				auto& sound = std::get<sf::Sound>(soundVariant);
-
-				sound.setBuffer(clip.GetBuffer());
-				sound.setVolume(specification.mute ? 0.0f : std::clamp(specification.volume, 0.0f, 100.0f));
-				sound.setPitch(std::max(0.0001f, specification.pitch));
-				sound.setLoop(specification.loop);
-				sound.play();
-			}
-			else if constexpr (std::is_same_v<T, SoundReference>)
-			{
-				soundVariant.emplace<Music>();
-				auto& stream = std::get<Music>(soundVariant);
-
-				if (!stream.setSoundReference(clip)) return false;
-				stream.setVolume(specification.mute ? 0.0f : std::clamp(specification.volume, 0.0f, 100.0f));
-				stream.setPitch(std::max(0.0001f, specification.pitch));
-				stream.setLoop(specification.loop);
-				stream.play();
-			}
+		AudioHandle PlayAudio(uint64_t entityID, const AudioClip& clip, const AudioSpecification& spec, std::optional<uint64_t> startTick);
+
+		AudioHandle PlayClip(uint64_t entityID, size_t clipID, const std::shared_ptr<Clip>& clip, bool stream, const AudioSpecification& specification, std::optional<uint64_t> startTick, AudioHandle victim);
+
+		bool StartSource(Source& source, const Clip& clip);
+
+		bool AcquireVoice(Source& source);
 
-			return true;
-		}
+		AudioHandle RejectPlay(PlayRejection reason);
+
+		static uint32_t SplitSourceVoices(uint32_t voices, bool stream);
 
 	private:
-		sf::Time m_CurrentTime;
+		uint64_t m_CurrentTick = 0;
+		uint32_t m_TickRate = c_DefaultTickRate;
+		double m_TickRemainder = 0; // part of a tick left over from Update(deltaTime)
+		uint64_t m_BackendTick = 0; // where the backend clock was at the last Update()
+		sf::Clock m_BackendClock; // the sources backend has no sample count to follow
+		int64_t m_MixerFrameOffset = 0; // mixed frames minus ticks at the last Update, to place scheduled voices in the mix
+		EventScheduler m_StartQueue; // scheduled plays, keyed by when they need a voice
+		uint64_t m_StreamUnderruns = 0; // decoder total at the last Update
 
 		AudioManager m_AudioManager;
 
-		std::unordered_map<uint64_t, Source> m_CurrentPlayingAudio;
-		std::set<AudioEventData> m_AudioEventQueue;
-		std::function<void(uint64_t)> m_OnAudioFinish;
+		Backend m_Backend = Backend::Sources;
+
+		VoicePool<sf::Sound> m_SoundPool;
+		VoicePool<Music> m_StreamPool;
+
+		std::unique_ptr<Mixer> m_Mixer; // only used by the mixer backend, it owns the voices for sounds and streams
+		std::unique_ptr<MixerStream> m_MixerStream; // null for the offline backend
+
+		SlotMap<Source> m_CurrentPlayingAudio;
+		std::unordered_map<uint64_t, AudioHandle> m_EntityHandles;
+		EventScheduler m_AudioEventQueue;
+		std::function<void(uint64_t, FinishReason)> m_OnAudioFinish;
+		std::vector<FinishEvent> m_FinishEvents; // filled until the next Update
+		std::vector<FinishEvent> m_PublishedFinishEvents; // what GetFinishEvents hands out
+		sf::Vector3f m_ListenerPosition;
+
+		CommandQueue<AudioCommandBuffer> m_CommandQueue;
+		AudioCommandBuffer m_QueuedCommands;
+
+		std::thread m_AudioThread;
+		std::atomic<bool> m_IsAudioThreadRunning = false;
+
+		std::vector<AudioHandle> m_PendingSources;
+		PendingClipPolicy m_PendingClipPolicy = PendingClipPolicy::Queue;
+
+		AudioStats m_Stats; // counters of the last finished frame
+		AudioStats m_FrameStats; // counters of the frame in progress
+		uint32_t m_RealStreamVoices = 0; // streams share voices with sounds on the mixer
+
+		RankScheduler m_StealIndex; // min-heap of every voice keyed by the steal policy, the top is stolen first
+		StealPolicy m_StealPolicy = StealPolicy::None;
+		uint32_t m_VoiceLimit = 0;
+		sf::Vector3f m_StealListener; // where the listener was when the steal keys were indexed
+		std::vector<RankScheduler::Event> m_StealCandidates; // scratch space for picking a victim
+		std::vector<AudioHandle> m_StolenSources; // fading out
+		size_t m_StolenCount = 0;
+
+		struct ClipPlayback
+		{
+			ClipPlaybackRules rules;
+			std::vector<AudioHandle> instances; // oldest first, only tracked with an instance limit or boosting
+			std::optional<uint64_t> lastTrigger;
+		};
+
+		std::unordered_map<size_t, ClipPlayback> m_ClipPlayback; // only clips that have rules
+
+		struct Bus
+		{
+			BusHandle parent = c_MasterBus;
+			float volume = 100;
+			bool isPaused = false;
+			uint64_t stopSequence = 0; // voices played before this are stopped
+			std::vector<AudioHandle> voices; // in no particular order
+
+			// combined with every bus above it
+			float gain = 1;
+			bool isEffectivelyPaused = false;
+			uint64_t effectiveStopSequence = 0;
+			bool hasVoiceChanges = false; // its voices have to catch up with the last ApplyBuses
+		};
 
-		static constexpr uint8_t c_MaxAudioEmitters = 255;
+		std::vector<Bus> m_Buses = { Bus() }; // parents always come before their children, the first is the master bus
+		bool m_AreBusesDirty = false;
+		std::vector<Mixer::Bus> m_MixerBuses; // what was last handed to the mixer
+		uint64_t m_PlaySequence = 0;
+
+		std::vector<Source*> m_RankedSources; // scratch space for voice ranking
+		std::vector<AudioHandle> m_ResolvedHandles; // scratch space for bulk calls
+		std::vector<size_t> m_PromotedSources; // indices into the ranked sources
+		std::vector<size_t> m_DemotedSources;
+		std::vector<AudioHandle> m_InvalidSources;
+
+		static constexpr uint32_t c_DefaultSoundVoices = 239;
+		static constexpr uint32_t c_DefaultStreamVoices = 16; // shares the backend source budget with sounds
+		static constexpr uint32_t c_DefaultMixerVoices = 1024;
+		static constexpr uint32_t c_MaxSourceVoices = c_DefaultSoundVoices + c_DefaultStreamVoices; // what the backend can open at once
+		static constexpr size_t c_CommandQueueCapacity = 256;
+		static constexpr size_t c_RenderBlockFrames = 512; // how often the engine advances while rendering offline
+		static constexpr float c_StealFadeTime = 0.05f;
+		static constexpr size_t c_StealCandidateLimit = 32; // past this many close keys the steal index is rebuilt
+		static constexpr float c_RebalanceHysteresis = 1.25f; // how much more audible a virtual voice must be to take over a real one
+		static constexpr uint32_t c_DefaultTickRate = Mixer::c_DefaultSampleRate; // the sources backend has no output rate of its own
+		static constexpr uint64_t c_NoDeadline = std::numeric_limits<uint64_t>::max(); // loops
+		static constexpr float c_ScheduleLookahead = 0.1f; // how early the mixer backends hand scheduled plays a voice
+		static constexpr size_t c_DecodeThreadCount = 2; // shared by every streamed voice of the mixer backend
 	};
 
 } // Mix
\ No newline at end of file
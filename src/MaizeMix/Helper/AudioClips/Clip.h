@@ -2,12 +2,18 @@
 
 #include <SFML/Audio.hpp>
 #include <cstdint>
+#include <atomic>
 
 namespace Mix {
 
 	class Clip
 	{
 	 public:
+		enum class State : uint8_t { Unloaded = 0, Loaded, Failed };
+
+		// how the audio data is kept, decompressed clips are played as sounds and the rest are streamed
+		enum class LoadType : uint8_t { DecompressOnLoad = 0, CompressedInMemory, Streaming, Count };
+
 		virtual ~Clip() = default;
 
 		virtual bool OpenFromFile(const std::string& filename) = 0;
@@ -16,6 +22,20 @@ namespace Mix {
 		virtual uint32_t GetChannelCount() const = 0;
 		virtual uint32_t GetSampleRate() const = 0;
 		virtual uint64_t GetSampleCount() const = 0;
+		virtual size_t GetMemoryUsage() const = 0; // bytes of audio data kept in memory
+
+		// the clip data is only safe to read once the state says it is loaded, it may still be decoding on another thread
+		State GetState() const { return m_State.load(std::memory_order_acquire); }
+		void SetState(State state) { m_State.store(state, std::memory_order_release); }
+		bool IsLoaded() const { return GetState() == State::Loaded; }
+
+		// seconds it took to open, and for sounds decode, the clip; set before the state so it is safe to read once loaded
+		float GetLoadTime() const { return m_LoadTime; }
+		void SetLoadTime(float seconds) { m_LoadTime = seconds; }
+
+	 private:
+		std::atomic<State> m_State = State::Unloaded;
+		float m_LoadTime = 0;
 	};
 
 } // Mix
\ No newline at end of file
@@ -0,0 +1,47 @@
+#include "MaizeMix/Helper/AudioClips/CompressedBuffer.h"
+
+#include <fstream>
+
+namespace Mix {
+
+	CompressedBuffer::~CompressedBuffer()
+	{
+		ResetReferences();
+	}
+
+	bool CompressedBuffer::OpenFromFile(const std::string& filename)
+	{
+		std::ifstream file(filename, std::ios::binary | std::ios::ate);
+
+		if (!file) return false;
+
+		m_Data.resize(static_cast<size_t>(file.tellg()));
+		file.seekg(0);
+
+		if (file.read(m_Data.data(), static_cast<std::streamsize>(m_Data.size())) && ReadHeader())
+		{
+			m_Data.shrink_to_fit();
+			return true;
+		}
+
+		m_Data = {};
+
+		return false;
+	}
+
+	size_t CompressedBuffer::GetMemoryUsage() const
+	{
+		return m_Data.capacity() + GetHeadMemoryUsage();
+	}
+
+	const void* CompressedBuffer::GetData() const
+	{
+		return m_Data.data();
+	}
+
+	size_t CompressedBuffer::GetSize() const
+	{
+		return m_Data.size();
+	}
+
+} // Mix
\ No newline at end of file
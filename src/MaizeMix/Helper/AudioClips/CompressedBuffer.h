@@ -0,0 +1,31 @@
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include "MaizeMix/Helper/AudioClips/StreamedClip.h"
+
+namespace Mix {
+
+	/**
+	 * Keeps the encoded file (ogg, flac...) in memory and decodes it while playing
+	 * Much smaller than a SoundBuffer for long clips, and playing it never touches the disk
+	 */
+	class CompressedBuffer final : public StreamedClip
+	{
+	 public:
+		CompressedBuffer() = default;
+		~CompressedBuffer() override;
+
+		bool OpenFromFile(const std::string& filename) override;
+
+		size_t GetMemoryUsage() const override;
+
+		const void* GetData() const override;
+		size_t GetSize() const override;
+
+	 private:
+		std::vector<char> m_Data;
+	};
+
+} // Mix
\ No newline at end of file
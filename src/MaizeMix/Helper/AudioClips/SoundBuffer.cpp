@@ -27,6 +27,11 @@ namespace Mix {
 		return m_Buffer.getSampleCount();
 	}
 
+	size_t SoundBuffer::GetMemoryUsage() const
+	{
+		return m_Buffer.getSampleCount() * sizeof(sf::Int16);
+	}
+
 	const sf::SoundBuffer& SoundBuffer::GetBuffer() const
 	{
 		return m_Buffer;
@@ -15,6 +15,7 @@ namespace Mix {
 		uint32_t GetChannelCount() const override;
 		uint32_t GetSampleRate() const override;
 		uint64_t GetSampleCount() const override;
+		size_t GetMemoryUsage() const override;
 
 		const sf::SoundBuffer& GetBuffer() const;
 
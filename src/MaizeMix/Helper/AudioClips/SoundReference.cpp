@@ -1,64 +1,36 @@
 #include "MaizeMix/Helper/AudioClips/SoundReference.h"
-#include "MaizeMix/Helper/Music.h"
 
 namespace Mix {
 
 	SoundReference::~SoundReference()
 	{
-		std::set<Music*> music;
-		music.swap(m_References);
-
-		for (auto* it : music)
-		{
-			it->resetReference();
-		}
+		ResetReferences();
 	}
 
 	bool SoundReference::OpenFromFile(const std::string& filename)
 	{
-		if (m_File.openFromFile(filename))
-		{
-			m_AudioPath = filename;
-
-			m_Duration = m_File.getDuration();
-			m_ChannelCount = m_File.getChannelCount();
-			m_SampleRate = m_File.getSampleRate();
-			m_SampleCount = m_File.getSampleOffset();
+		if (!m_Mapping.Open(filename)) return false;
+		if (ReadHeader()) return true;
 
-			return true;
-		}
+		m_Mapping.Close();
 
 		return false;
 	}
 
-	sf::Time SoundReference::GetDuration() const
-	{
-		return m_Duration;
-	}
-
-	uint32_t SoundReference::GetChannelCount() const
-	{
-		return m_ChannelCount;
-	}
-
-	uint32_t SoundReference::GetSampleRate() const
-	{
-		return m_SampleRate;
-	}
-
-	uint64_t SoundReference::GetSampleCount() const
+	size_t SoundReference::GetMemoryUsage() const
 	{
-		return m_SampleCount;
+		// the encoded file is mapped rather than allocated, the os can page it back out, the head is not
+		return m_Mapping.GetSize() + GetHeadMemoryUsage();
 	}
 
-	void SoundReference::AttachReference(Music* music) const
+	const void* SoundReference::GetData() const
 	{
-		m_References.insert(music);
+		return m_Mapping.GetData();
 	}
 
-	void SoundReference::DetachReference(Music* music) const
+	size_t SoundReference::GetSize() const
 	{
-		m_References.erase(music);
+		return m_Mapping.GetSize();
 	}
 
 } // Mix
\ No newline at end of file
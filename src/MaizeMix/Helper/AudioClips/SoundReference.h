@@ -1,16 +1,13 @@
 #pragma once
 
-#include <SFML/Audio.hpp>
-#include <cstdint>
 #include <string>
 
-#include "MaizeMix/Helper/AudioClips/Clip.h"
+#include "MaizeMix/Helper/AudioClips/StreamedClip.h"
+#include "MaizeMix/Helper/MappedFile.h"
 
 namespace Mix {
 
-	class Music;
-
-	class SoundReference final : public Clip
+	class SoundReference final : public StreamedClip
 	{
 	 public:
 		SoundReference() = default;
@@ -18,26 +15,13 @@ namespace Mix {
 
 		bool OpenFromFile(const std::string& filename) override;
 
-		sf::Time GetDuration() const override;
-		uint32_t GetChannelCount() const override;
-		uint32_t GetSampleRate() const override;
-		uint64_t GetSampleCount() const override;
+		size_t GetMemoryUsage() const override;
 
-	 private:
-		void AttachReference(Music* music) const;
-		void DetachReference(Music* music) const;
+		const void* GetData() const override;
+		size_t GetSize() const override;
 
 	 private:
-		friend class Music;
-
-		sf::Time m_Duration;
-		uint32_t m_ChannelCount = 0;
-		uint32_t m_SampleRate = 0;
-		uint64_t m_SampleCount = 0;
-
-		sf::InputSoundFile m_File;
-		std::string m_AudioPath; // used for sf::Music to act like setBuffer which would instead do openFromFile
-		mutable std::set<Music*> m_References;
+		MappedFile m_Mapping; // shared by every sf::Music streaming this clip so starting one doesn't touch the disk
 	};
 
 } // Mix
\ No newline at end of file
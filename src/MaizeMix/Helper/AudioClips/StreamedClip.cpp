@@ -0,0 +1,111 @@
+#include "MaizeMix/Helper/AudioClips/StreamedClip.h"
+#include "MaizeMix/Helper/Music.h"
+
+#include <algorithm>
+
+namespace Mix {
+
+	StreamedClip::~StreamedClip()
+	{
+		ResetReferences();
+	}
+
+	sf::Time StreamedClip::GetDuration() const
+	{
+		return m_Duration;
+	}
+
+	uint32_t StreamedClip::GetChannelCount() const
+	{
+		return m_ChannelCount;
+	}
+
+	uint32_t StreamedClip::GetSampleRate() const
+	{
+		return m_SampleRate;
+	}
+
+	uint64_t StreamedClip::GetSampleCount() const
+	{
+		return m_SampleCount;
+	}
+
+	bool StreamedClip::SetHeadTime(float seconds)
+	{
+		std::shared_ptr<Head> head;
+
+		if (seconds > 0)
+		{
+			sf::InputSoundFile file;
+
+			if (!file.openFromMemory(GetData(), GetSize())) return false;
+
+			const auto frames = std::min(static_cast<uint64_t>(static_cast<double>(seconds) * file.getSampleRate()), file.getSampleCount() / file.getChannelCount());
+
+			head = std::make_shared<Head>(static_cast<size_t>(frames * file.getChannelCount()));
+			head->resize(static_cast<size_t>(file.read(head->data(), head->size())));
+
+			if (head->empty()) head.reset();
+		}
+
+		std::lock_guard lock(m_HeadMutex);
+
+		m_Head = std::move(head);
+
+		return true;
+	}
+
+	std::shared_ptr<const StreamedClip::Head> StreamedClip::GetHead() const
+	{
+		std::lock_guard lock(m_HeadMutex);
+
+		return m_Head;
+	}
+
+	bool StreamedClip::ReadHeader()
+	{
+		// only the header is needed from here, the samples are decoded by each sf::Music
+		sf::InputSoundFile file;
+
+		if (file.openFromMemory(GetData(), GetSize()))
+		{
+			m_Duration = file.getDuration();
+			m_ChannelCount = file.getChannelCount();
+			m_SampleRate = file.getSampleRate();
+			m_SampleCount = file.getSampleCount();
+
+			return true;
+		}
+
+		return false;
+	}
+
+	size_t StreamedClip::GetHeadMemoryUsage() const
+	{
+		std::lock_guard lock(m_HeadMutex);
+
+		return m_Head != nullptr ? m_Head->capacity() * sizeof(sf::Int16) : 0;
+	}
+
+	void StreamedClip::ResetReferences()
+	{
+		std::set<Music*> music;
+		music.swap(m_References);
+
+		for (auto* it : music)
+		{
+			it->resetReference();
+		}
+	}
+
+	void StreamedClip::AttachReference(Music* music) const
+	{
+		m_References.insert(music);
+	}
+
+	void StreamedClip::DetachReference(Music* music) const
+	{
+		m_References.erase(music);
+	}
+
+} // Mix
\ No newline at end of file
@@ -0,0 +1,69 @@
+#pragma once
+
+#include <SFML/Audio.hpp>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <vector>
+#include <set>
+
+#include "MaizeMix/Helper/AudioClips/Clip.h"
+
+namespace Mix {
+
+	class Music;
+
+	/**
+	 * Base of clips that keep their encoded file in memory and are decoded by a Music while playing
+	 * Implementations only decide where the encoded bytes live
+	 */
+	class StreamedClip : public Clip
+	{
+	 public:
+		~StreamedClip() override;
+
+		sf::Time GetDuration() const override;
+		uint32_t GetChannelCount() const override;
+		uint32_t GetSampleRate() const override;
+		uint64_t GetSampleCount() const override;
+
+		virtual const void* GetData() const = 0;
+		virtual size_t GetSize() const = 0;
+
+		using Head = std::vector<sf::Int16>;
+
+		/**
+		 * Decodes the first seconds of the clip and keeps them in memory, 0 frees them again
+		 * Voices started after this play the head straight away and only decode what comes after it
+		 */
+		bool SetHeadTime(float seconds);
+
+		// interleaved samples, null without a head; playing voices keep the one they started with
+		std::shared_ptr<const Head> GetHead() const;
+
+	 protected:
+		bool ReadHeader();
+		size_t GetHeadMemoryUsage() const;
+
+		// has to be called by implementations before they free their data, every music reading it is stopped
+		void ResetReferences();
+
+	 private:
+		void AttachReference(Music* music) const;
+		void DetachReference(Music* music) const;
+
+	 private:
+		friend class Music;
+
+		sf::Time m_Duration;
+		uint32_t m_ChannelCount = 0;
+		uint32_t m_SampleRate = 0;
+		uint64_t m_SampleCount = 0;
+
+		std::shared_ptr<const Head> m_Head;
+		mutable std::mutex m_HeadMutex; // the head may be swapped while another thread starts a voice or counts memory
+
+		mutable std::set<Music*> m_References;
+	};
+
+} // Mix
\ No newline at end of file
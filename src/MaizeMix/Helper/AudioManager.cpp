@@ -1,57 +1,209 @@
 #include "MaizeMix/Helper/AudioManager.h"
 
+#include "MaizeMix/Helper/AudioClips/CompressedBuffer.h"
 #include "MaizeMix/Helper/AudioClips/SoundReference.h"
 #include "MaizeMix/Helper/AudioClips/SoundBuffer.h"
 #include "MaizeMix/AudioClip.h"
 
 namespace Mix {
 
-    AudioClip AudioManager::CreateClip(const std::string &filePath, bool stream)
+    AudioClip AudioManager::CreateClip(const std::string& filePath, bool stream)
     {
-        static size_t id = 0;
+        return CreateClip(filePath, ToLoadType(stream));
+    }
+
+    AudioClip AudioManager::CreateClip(const std::string& filePath, Clip::LoadType loadType)
+    {
+        if (auto cached = FindClip(filePath, loadType); cached.IsValid()) return cached;
+
+        auto clip = MakeClip(loadType);
 
         // sfml boilerplate to create audio data
-        if (stream)
+        if (LoadClip(*clip, filePath))
         {
-            auto soundReference = std::make_shared<SoundReference>();
+            return AddClip(clip, filePath, loadType);
+        }
+
+        // return a failed audio clip
+        return {c_InvalidClip, nullptr, loadType, AudioClip::LoadState::Failed };
+    }
+
+    AudioClip AudioManager::CreateClipAsync(const std::string& filePath, bool stream)
+    {
+        return CreateClipAsync(filePath, ToLoadType(stream));
+    }
+
+    AudioClip AudioManager::CreateClipAsync(const std::string& filePath, Clip::LoadType loadType)
+    {
+        if (auto cached = FindClip(filePath, loadType); cached.IsValid()) return cached;
+
+        auto clip = MakeClip(loadType);
+        auto audioClip = AddClip(clip, filePath, loadType); // handed out as unloaded until the worker is done with it
+
+        // someone else got to this path first, so there is nothing left to load
+        if (audioClip.m_Handle.lock() != clip) return audioClip;
+
+        {
+            std::lock_guard lock(m_ClipMutex);
+
+            if (m_LoadPool == nullptr) m_LoadPool = std::make_unique<ThreadPool>(c_LoadThreadCount);
+        }
+
+        m_LoadPool->Enqueue([clip, filePath]()
+        {
+            LoadClip(*clip, filePath);
+        });
+
+        return audioClip;
+    }
 
-            if (soundReference->OpenFromFile(filePath))
+    void AudioManager::DestroyClip(AudioClip &clip)
+    {
+        // remove clip once nothing else holds on to it
+        {
+            std::lock_guard lock(m_ClipMutex);
+
+            if (const auto it = m_AudioClips.find(clip.m_ClipID); it != m_AudioClips.end() && --it->second.references == 0)
             {
-                id++;
+                auto& paths = m_ClipPaths[static_cast<size_t>(it->second.loadType)];
 
-                auto clip = AudioClip(id, soundReference, stream, AudioClip::LoadState::Loaded);
-                m_AudioClips.try_emplace(id, soundReference);
+                // a failed clip may have already been replaced by a newer load of the same path
+                if (const auto path = paths.find(it->second.filePath); path != paths.end() && path->second == it->first)
+                {
+                    paths.erase(path);
+                }
 
-                return clip;
+                m_AudioClips.erase(it);
             }
         }
-        else
+
+        // set clip to default
+        clip = AudioClip();
+    }
+
+    bool AudioManager::SetStreamHead(const AudioClip& clip, float seconds)
+    {
+        const auto handle = clip.m_Handle.lock();
+
+        // only clips decoded while playing have a head to keep
+        if (handle == nullptr || !handle->IsLoaded() || clip.m_LoadType == Clip::LoadType::DecompressOnLoad) return false;
+
+        return std::static_pointer_cast<StreamedClip>(handle)->SetHeadTime(seconds);
+    }
+
+    uint32_t AudioManager::GetReferenceCount(const AudioClip& clip) const
+    {
+        std::lock_guard lock(m_ClipMutex);
+
+        if (const auto it = m_AudioClips.find(clip.m_ClipID); it != m_AudioClips.end())
         {
-            auto soundBuffer = std::make_shared<SoundBuffer>();
+            return it->second.references;
+        }
 
-            if (soundBuffer->OpenFromFile(filePath))
-            {
-                id++;
+        return 0;
+    }
+
+    size_t AudioManager::GetClipCount() const
+    {
+        std::lock_guard lock(m_ClipMutex);
+
+        return m_AudioClips.size();
+    }
+
+    size_t AudioManager::GetMemoryUsage() const
+    {
+        std::lock_guard lock(m_ClipMutex);
+
+        size_t usage = 0;
+
+        for (const auto& [id, entry] : m_AudioClips)
+        {
+            if (entry.clip->IsLoaded()) usage += entry.clip->GetMemoryUsage();
+        }
+
+        return usage;
+    }
 
-                auto clip = AudioClip(id, soundBuffer, stream, AudioClip::LoadState::Loaded);
+    float AudioManager::GetLoadTime() const
+    {
+        std::lock_guard lock(m_ClipMutex);
+
+        float loadTime = 0;
 
-                m_AudioClips.emplace(id, soundBuffer);
+        for (const auto& [id, entry] : m_AudioClips)
+        {
+            if (entry.clip->IsLoaded()) loadTime += entry.clip->GetLoadTime();
+        }
+
+        return loadTime;
+    }
+
+    Clip::LoadType AudioManager::ToLoadType(bool stream)
+    {
+        return stream ? Clip::LoadType::Streaming : Clip::LoadType::DecompressOnLoad;
+    }
+
+    std::shared_ptr<Clip> AudioManager::MakeClip(Clip::LoadType loadType)
+    {
+        switch (loadType)
+        {
+            case Clip::LoadType::CompressedInMemory: return std::make_shared<CompressedBuffer>();
+            case Clip::LoadType::Streaming: return std::make_shared<SoundReference>();
+            default: return std::make_shared<SoundBuffer>();
+        }
+    }
 
-                return clip;
+    bool AudioManager::LoadClip(Clip& clip, const std::string& filePath)
+    {
+        const sf::Clock clock;
+        const bool successful = clip.OpenFromFile(filePath);
+
+        clip.SetLoadTime(clock.getElapsedTime().asSeconds());
+        clip.SetState(successful ? Clip::State::Loaded : Clip::State::Failed);
+
+        return successful;
+    }
+
+    AudioClip AudioManager::FindClip(const std::string& filePath, Clip::LoadType loadType)
+    {
+        std::lock_guard lock(m_ClipMutex);
+
+        const auto& paths = m_ClipPaths[static_cast<size_t>(loadType)];
+
+        if (const auto path = paths.find(filePath); path != paths.end())
+        {
+            auto& entry = m_AudioClips.at(path->second);
+
+            // let a failed load try again
+            if (entry.clip->GetState() != Clip::State::Failed)
+            {
+                entry.references++;
+
+                return {path->second, entry.clip, loadType, entry.clip->GetState() };
             }
         }
 
-        // return a failed audio clip
-        return {c_InvalidClip, nullptr, stream, AudioClip::LoadState::Failed };
+        return {};
     }
 
-    void AudioManager::DestroyClip(AudioClip &clip)
+    AudioClip AudioManager::AddClip(const std::shared_ptr<Clip>& clip, const std::string& filePath, Clip::LoadType loadType)
     {
-        // remove clip
-        m_AudioClips.erase(clip.m_ClipID);
+        std::lock_guard lock(m_ClipMutex);
 
-        // set clip to default
-        clip = AudioClip();
+        auto& clipID = m_ClipPaths[static_cast<size_t>(loadType)][filePath];
+
+        // another thread may have loaded the same path while this one was decoding
+        if (const auto it = m_AudioClips.find(clipID); it != m_AudioClips.end() && it->second.clip->GetState() != Clip::State::Failed)
+        {
+            it->second.references++;
+
+            return {clipID, it->second.clip, loadType, it->second.clip->GetState() };
+        }
+
+        clipID = ++m_NextClipID;
+        m_AudioClips.emplace(clipID, ClipEntry{ clip, filePath, loadType, 1 });
+
+        return {clipID, clip, loadType, clip->GetState() };
     }
 
 } // Mix
\ No newline at end of file
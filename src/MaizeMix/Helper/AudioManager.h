@@ -3,21 +3,57 @@
 #include <unordered_map>
 #include <string>
 #include <memory>
+#include <mutex>
+#include <array>
 
-namespace Mix {
+#include "MaizeMix/Helper/AudioClips/Clip.h"
+#include "MaizeMix/Helper/ThreadPool.h"
 
-    class Clip;
+namespace Mix {
     class AudioClip;
 
     class AudioManager
     {
     public:
+        /** Loading a path that is already loaded hands back the same clip, every create needs a matching destroy. */
         AudioClip CreateClip(const std::string& filePath, bool stream);
+        AudioClip CreateClip(const std::string& filePath, Clip::LoadType loadType);
+        AudioClip CreateClipAsync(const std::string& filePath, bool stream);
+        AudioClip CreateClipAsync(const std::string& filePath, Clip::LoadType loadType);
         void DestroyClip(AudioClip& clip);
 
+        /** Keeps the first seconds of a loaded streamed clip decoded so voices start without waiting on the decoder, 0 to drop it. */
+        bool SetStreamHead(const AudioClip& clip, float seconds);
+
+        uint32_t GetReferenceCount(const AudioClip& clip) const;
+        size_t GetClipCount() const;
+        size_t GetMemoryUsage() const; // bytes of audio data across all loaded clips
+        float GetLoadTime() const; // seconds spent loading all loaded clips
+
     private:
-        std::unordered_map<size_t, std::shared_ptr<Clip>> m_AudioClips;
+        struct ClipEntry
+        {
+            std::shared_ptr<Clip> clip;
+            std::string filePath;
+            Clip::LoadType loadType = Clip::LoadType::DecompressOnLoad;
+            uint32_t references = 0;
+        };
+
+        static Clip::LoadType ToLoadType(bool stream);
+        static std::shared_ptr<Clip> MakeClip(Clip::LoadType loadType);
+        static bool LoadClip(Clip& clip, const std::string& filePath);
+        AudioClip FindClip(const std::string& filePath, Clip::LoadType loadType);
+        AudioClip AddClip(const std::shared_ptr<Clip>& clip, const std::string& filePath, Clip::LoadType loadType);
+
+    private:
+        std::unordered_map<size_t, ClipEntry> m_AudioClips;
+        std::array<std::unordered_map<std::string, size_t>, static_cast<size_t>(Clip::LoadType::Count)> m_ClipPaths; // one lookup for each load mode
+        size_t m_NextClipID = 0;
+        mutable std::mutex m_ClipMutex; // clips may be created from any thread
+
+        std::unique_ptr<ThreadPool> m_LoadPool; // only started once something loads asynchronously
         static constexpr uint8_t c_InvalidClip = 0;
+        static constexpr size_t c_LoadThreadCount = 2;
     };
 
 } // Mix
\ No newline at end of file
@@ -1,5 +1,7 @@
 #pragma once
 
+#include <cstdint>
+
 namespace Mix {
 
 	struct AudioSpecification
@@ -8,12 +10,26 @@ namespace Mix {
 		bool loop = false;
 		float volume = 0.0f;
 		float pitch = 0.0f;
+		int32_t priority = 0; // higher priorities keep a real voice over lower ones
+		uint32_t bus = 0; // from AudioEngine::CreateBus, the master bus by default
 
 		AudioSpecification() = default;
-		AudioSpecification(bool loop, bool mute, float volume, float pitch)
-			: mute(mute), loop(loop), volume(volume), pitch(pitch)
+		AudioSpecification(bool loop, bool mute, float volume, float pitch, int32_t priority = 0, uint32_t bus = 0)
+			: mute(mute), loop(loop), volume(volume), pitch(pitch), priority(priority), bus(bus)
 		{
 		}
 	};
 
+	// how often a single clip can be played, shared by every entity playing it
+	struct ClipPlaybackRules
+	{
+		// what a play past the limits does, stealing only applies to the instance limit
+		enum class LimitPolicy : uint8_t { Reject = 0, StealOldest, BoostExisting };
+
+		uint32_t maxInstances = 0; // 0 for no limit
+		float retriggerInterval = 0.0f; // seconds before the clip can be started again
+		LimitPolicy policy = LimitPolicy::Reject;
+		float boostVolume = 10.0f; // added to the newest instance instead of playing another
+	};
+
 } // Mix
\ No newline at end of file
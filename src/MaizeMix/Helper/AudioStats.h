@@ -0,0 +1,63 @@
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include <array>
+
+namespace Mix {
+
+	// why PlayAudio handed back an invalid handle
+	enum class PlayRejection : uint8_t
+	{
+		ExpiredClip = 0, // the clip was removed
+		FailedClip, // the clip failed to load, also counted for a queued play once its clip fails
+		PendingClip, // the clip is still loading and the pending clip policy is to reject
+		DuplicateEntity,
+		BackendFailure, // the backend voice couldn't open the clip
+		VoiceLimit, // every voice outranks the new one under the steal policy
+		ClipLimit, // the clip is already playing as many times as its rules allow
+		ClipRetrigger, // the clip was started too recently
+		Count
+	};
+
+	/**
+	 * Snapshot of the engine returned by AudioEngine::GetStats
+	 * Counters cover the last frame, from the end of one Update to the end of the next
+	 */
+	struct AudioStats
+	{
+		// voices bound to a backend voice, the rest are virtual
+		uint32_t soundVoices = 0;
+		uint32_t streamVoices = 0;
+		uint32_t virtualVoices = 0;
+
+		uint32_t voicesStarted = 0;
+		uint32_t voicesFinished = 0; // reached the end of their clip or lost it
+		uint32_t voicesStopped = 0;
+		uint32_t voicesStolen = 0;
+		std::array<uint32_t, static_cast<size_t>(PlayRejection::Count)> rejectedPlays = {};
+
+		float updateTime = 0; // seconds spent in Update
+		float mixTime = 0; // seconds the software mixer took for its last block, streams are decoded as part of it without decode workers
+		uint32_t streamUnderruns = 0; // blocks where a streamed mixer voice ran out of decoded audio
+
+		size_t clipCount = 0;
+		size_t clipMemory = 0; // bytes of audio data held by loaded clips
+		float clipLoadTime = 0; // seconds spent loading the clips that are held
+
+		uint32_t GetRejectedPlays(PlayRejection reason) const
+		{
+			return rejectedPlays[static_cast<size_t>(reason)];
+		}
+
+		uint32_t GetRejectedPlays() const
+		{
+			uint32_t total = 0;
+
+			for (const uint32_t count : rejectedPlays) total += count;
+
+			return total;
+		}
+	};
+
+} // Mix
\ No newline at end of file
@@ -0,0 +1,92 @@
+#pragma once
+
+#include <atomic>
+#include <cassert>
+#include <cstddef>
+#include <memory>
+#include <utility>
+
+namespace Mix {
+
+	/**
+	 * Bounded lock-free multi-producer/single-consumer ring (based on Dmitry Vyukov's bounded queue)
+	 * Values are swapped in and out of preallocated cells, so pushing a container hands back the storage of one that
+	 * was consumed earlier and nothing is allocated once every cell has been used
+	 */
+	template <typename T>
+	class CommandQueue
+	{
+	 public:
+		explicit CommandQueue(size_t capacity) : m_Cells(std::make_unique<Cell[]>(capacity)), m_Mask(capacity - 1)
+		{
+			assert(capacity >= 2 && (capacity & (capacity - 1)) == 0 && "capacity must be a power of two");
+
+			for (size_t i = 0; i < capacity; i++)
+			{
+				m_Cells[i].sequence.store(i, std::memory_order_relaxed);
+			}
+		}
+
+		// safe to call from any thread, fails instead of blocking when the queue is full
+		bool TryPush(T& value)
+		{
+			size_t position = m_EnqueuePosition.load(std::memory_order_relaxed);
+			Cell* cell;
+
+			while (true)
+			{
+				cell = &m_Cells[position & m_Mask];
+
+				const size_t sequence = cell->sequence.load(std::memory_order_acquire);
+				const auto difference = static_cast<std::ptrdiff_t>(sequence) - static_cast<std::ptrdiff_t>(position);
+
+				if (difference == 0)
+				{
+					if (m_EnqueuePosition.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) break;
+				}
+				else if (difference < 0)
+				{
+					return false; // full
+				}
+				else
+				{
+					position = m_EnqueuePosition.load(std::memory_order_relaxed);
+				}
+			}
+
+			std::swap(cell->value, value);
+			cell->sequence.store(position + 1, std::memory_order_release);
+
+			return true;
+		}
+
+		// only ever call from the consuming thread
+		bool TryPop(T& value)
+		{
+			const size_t position = m_DequeuePosition;
+			Cell& cell = m_Cells[position & m_Mask];
+
+			if (cell.sequence.load(std::memory_order_acquire) != position + 1) return false; // empty
+
+			std::swap(cell.value, value);
+			cell.sequence.store(position + m_Mask + 1, std::memory_order_release);
+			m_DequeuePosition = position + 1;
+
+			return true;
+		}
+
+	 private:
+		struct Cell
+		{
+			std::atomic<size_t> sequence;
+			T value;
+		};
+
+		std::unique_ptr<Cell[]> m_Cells;
+		const size_t m_Mask;
+
+		alignas(64) std::atomic<size_t> m_EnqueuePosition = 0;
+		alignas(64) size_t m_DequeuePosition = 0;
+	};
+
+} // Mix
\ No newline at end of file
@@ -0,0 +1,219 @@
+#include "MaizeMix/Helper/DecodeStream.h"
+#include "MaizeMix/Helper/AudioClips/StreamedClip.h"
+
+#include <algorithm>
+
+namespace Mix {
+
+	bool DecodeStream::Open(const std::shared_ptr<const StreamedClip>& clip)
+	{
+		std::lock_guard lock(m_Mutex);
+
+		m_Head = clip->GetHead();
+		m_IsDecoderOpen = m_Head == nullptr;
+
+		// with a head the voice can start before the decoder is even open
+		if (m_IsDecoderOpen && !m_Decoder.openFromMemory(clip->GetData(), clip->GetSize())) return false;
+
+		m_Clip = clip;
+		m_ChannelCount = clip->GetChannelCount();
+		m_SampleRate = clip->GetSampleRate();
+		m_Ring.assign(c_RingFrames * m_ChannelCount, 0);
+		m_ReadFrame = 0;
+		m_WriteFrame = 0;
+		m_IsEndOfClip = false;
+		m_SeekFrame.reset();
+
+		WriteHead(0);
+
+		return true;
+	}
+
+	void DecodeStream::SetLoop(bool loop)
+	{
+		m_Loop.store(loop, std::memory_order_relaxed);
+	}
+
+	void DecodeStream::Seek(uint64_t frame)
+	{
+		// left to whoever refills next so the mixer never waits on the decoder, or on a worker holding it
+		m_SeekRequest.store(frame + 1, std::memory_order_release);
+	}
+
+	size_t DecodeStream::Refill(size_t maxFrames)
+	{
+		std::lock_guard lock(m_Mutex);
+
+		const auto clip = m_Clip.lock();
+
+		if (clip == nullptr || m_ChannelCount == 0) return 0;
+
+		if (!m_IsDecoderOpen)
+		{
+			m_IsDecoderOpen = m_Decoder.openFromMemory(clip->GetData(), clip->GetSize());
+
+			// the header was already read when the clip loaded, so whatever is left of the head is all there is
+			if (!m_IsDecoderOpen)
+			{
+				m_IsEndOfClip = true;
+				return 0;
+			}
+		}
+
+		if (uint64_t request = m_SeekRequest.load(std::memory_order_acquire); request != 0)
+		{
+			m_IsEndOfClip = false;
+
+			// the reader leaves the read position alone while a seek is waiting
+			m_ReadFrame.store(m_WriteFrame.load(std::memory_order_relaxed), std::memory_order_relaxed);
+
+			WriteHead(request - 1);
+
+			// a newer seek is left for the next refill
+			m_SeekRequest.compare_exchange_strong(request, 0, std::memory_order_acq_rel);
+		}
+
+		if (m_SeekFrame.has_value())
+		{
+			m_Decoder.seek(*m_SeekFrame * m_ChannelCount);
+			m_SeekFrame.reset();
+		}
+
+		uint64_t write = m_WriteFrame.load(std::memory_order_relaxed);
+		const uint64_t read = m_ReadFrame.load(std::memory_order_acquire);
+
+		size_t wanted = std::min(maxFrames, c_RingFrames - static_cast<size_t>(write - read));
+		size_t decoded = 0;
+		bool rewound = false;
+
+		while (wanted > 0)
+		{
+			// the loop was switched on after the end was reached
+			if (m_IsEndOfClip)
+			{
+				if (!m_Loop.load(std::memory_order_relaxed)) break;
+
+				m_Decoder.seek(sf::Uint64(0));
+				m_IsEndOfClip = false;
+			}
+
+			// decode straight into the ring, up to where it wraps
+			const size_t index = static_cast<size_t>(write % c_RingFrames);
+			const size_t count = std::min(wanted, c_RingFrames - index);
+			const auto frames = static_cast<size_t>(m_Decoder.read(m_Ring.data() + index * m_ChannelCount, count * m_ChannelCount)) / m_ChannelCount;
+
+			if (frames > 0)
+			{
+				write += frames;
+				wanted -= frames;
+				decoded += frames;
+				rewound = false;
+
+				// published as it goes so the mixer can start on it
+				m_WriteFrame.store(write, std::memory_order_release);
+				continue;
+			}
+
+			// nothing came out straight after rewinding either, so the clip is empty
+			if (rewound) break;
+
+			if (m_Loop.load(std::memory_order_relaxed))
+			{
+				m_Decoder.seek(sf::Uint64(0));
+				rewound = true;
+			}
+			else
+			{
+				m_IsEndOfClip = true;
+			}
+		}
+
+		return decoded;
+	}
+
+	size_t DecodeStream::WriteHead(uint64_t frame)
+	{
+		// called with the ring empty, the decoder is sent to wherever the copy stops
+		const uint64_t headFrames = m_Head != nullptr ? m_Head->size() / m_ChannelCount : 0;
+		const size_t count = frame < headFrames ? static_cast<size_t>(std::min<uint64_t>(headFrames - frame, c_RingFrames)) : 0;
+		const uint64_t write = m_WriteFrame.load(std::memory_order_relaxed);
+
+		for (size_t done = 0; done < count;)
+		{
+			const size_t index = static_cast<size_t>((write + done) % c_RingFrames);
+			const size_t chunk = std::min(count - done, c_RingFrames - index);
+
+			std::copy_n(m_Head->data() + (frame + done) * m_ChannelCount, chunk * m_ChannelCount, m_Ring.data() + index * m_ChannelCount);
+			done += chunk;
+		}
+
+		m_WriteFrame.store(write + count, std::memory_order_release);
+		m_SeekFrame = frame + count;
+
+		return count;
+	}
+
+	size_t DecodeStream::Read(sf::Int16* samples, size_t frames)
+	{
+		// what is in the ring is from before the seek
+		if (m_SeekRequest.load(std::memory_order_acquire) != 0) return 0;
+
+		const uint64_t read = m_ReadFrame.load(std::memory_order_relaxed);
+		const uint64_t write = m_WriteFrame.load(std::memory_order_acquire);
+		const size_t count = std::min(frames, static_cast<size_t>(write - read));
+
+		for (size_t done = 0; done < count;)
+		{
+			const size_t index = static_cast<size_t>((read + done) % c_RingFrames);
+			const size_t chunk = std::min(count - done, c_RingFrames - index);
+
+			std::copy_n(m_Ring.data() + index * m_ChannelCount, chunk * m_ChannelCount, samples + done * m_ChannelCount);
+			done += chunk;
+		}
+
+		m_ReadFrame.store(read + count, std::memory_order_release);
+
+		return count;
+	}
+
+	bool DecodeStream::IsFinished() const
+	{
+		if (m_SeekRequest.load(std::memory_order_acquire) != 0) return false;
+
+		// checked in this order so a refill landing in between can't make a drained ring look finished
+		const bool isEndOfClip = m_IsEndOfClip.load(std::memory_order_acquire) && !m_Loop.load(std::memory_order_relaxed);
+
+		return isEndOfClip && m_ReadFrame.load(std::memory_order_relaxed) == m_WriteFrame.load(std::memory_order_acquire);
+	}
+
+	bool DecodeStream::NeedsRefill() const
+	{
+		if (m_Clip.expired()) return false;
+		if (m_SeekRequest.load(std::memory_order_relaxed) != 0) return true;
+		if (m_IsEndOfClip.load(std::memory_order_relaxed) && !m_Loop.load(std::memory_order_relaxed)) return false;
+
+		const uint64_t buffered = m_WriteFrame.load(std::memory_order_relaxed) - m_ReadFrame.load(std::memory_order_relaxed);
+
+		return buffered <= c_RingFrames - c_RingFrames / 4;
+	}
+
+	float DecodeStream::GetBufferedTime() const
+	{
+		if (m_SampleRate == 0 || m_SeekRequest.load(std::memory_order_relaxed) != 0) return 0.0f;
+
+		const uint64_t buffered = m_WriteFrame.load(std::memory_order_acquire) - m_ReadFrame.load(std::memory_order_acquire);
+
+		return static_cast<float>(buffered) / static_cast<float>(m_SampleRate);
+	}
+
+	void DecodeStream::AddUnderrun()
+	{
+		m_Underruns.fetch_add(1, std::memory_order_relaxed);
+	}
+
+	uint32_t DecodeStream::GetUnderruns() const
+	{
+		return m_Underruns.load(std::memory_order_relaxed);
+	}
+
+} // Mix
\ No newline at end of file
@@ -0,0 +1,75 @@
+#pragma once
+
+#include <SFML/Audio.hpp>
+#include <cstdint>
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <vector>
+
+namespace Mix {
+
+	class StreamedClip;
+
+	/**
+	 * Ring buffer of decoded frames for one streamed voice, refilled ahead of the mixer
+	 * Only the mixer reads from it, so reads and seeks never lock, every refill holds the decoder lock
+	 * The clip head (StreamedClip::SetHeadTime) is copied in instead of decoded, the decoder picks up after it
+	 */
+	class DecodeStream
+	{
+	 public:
+		bool Open(const std::shared_ptr<const StreamedClip>& clip);
+
+		void SetLoop(bool loop);
+
+		// the next refill flushes what was decoded and carries on from the new position, reads come up empty until then
+		void Seek(uint64_t frame);
+
+		// decodes into the free part of the ring, up to maxFrames, returns the frames decoded
+		size_t Refill(size_t maxFrames = c_RingFrames);
+
+		// returns the frames read, which is less than asked for once the ring runs dry
+		size_t Read(sf::Int16* samples, size_t frames);
+
+		// the clip ended without looping and every frame of it was read
+		bool IsFinished() const;
+
+		// enough of the ring is free to be worth decoding into, and there is something left to decode
+		bool NeedsRefill() const;
+
+		// seconds of audio decoded ahead of the mixer
+		float GetBufferedTime() const;
+
+		void AddUnderrun();
+		uint32_t GetUnderruns() const;
+
+		static constexpr size_t c_RingFrames = 16384;
+
+	 private:
+		size_t WriteHead(uint64_t frame);
+
+	 private:
+		std::weak_ptr<const StreamedClip> m_Clip; // decoding reads from its memory, so it is locked for the duration
+		sf::InputSoundFile m_Decoder;
+		std::mutex m_Mutex;
+
+		std::shared_ptr<const std::vector<sf::Int16>> m_Head;
+		bool m_IsDecoderOpen = false; // with a head, opening is left to the first refill
+		std::optional<uint64_t> m_SeekFrame; // where the decoder goes on the next refill
+
+		uint32_t m_ChannelCount = 0;
+		uint32_t m_SampleRate = 0;
+
+		std::vector<sf::Int16> m_Ring;
+		std::atomic<uint64_t> m_ReadFrame = 0; // frames ever read and written, the ring index is these modulo c_RingFrames
+		std::atomic<uint64_t> m_WriteFrame = 0;
+
+		std::atomic<uint64_t> m_SeekRequest = 0; // frame + 1 of a seek waiting on a refill, 0 when there is none
+		std::atomic<bool> m_Loop = false;
+		std::atomic<bool> m_IsEndOfClip = false; // the decoder hit the end of a clip that doesn't loop
+		std::atomic<uint32_t> m_Underruns = 0;
+	};
+
+} // Mix
\ No newline at end of file
@@ -0,0 +1,152 @@
+#include "MaizeMix/Helper/EventScheduler.h"
+
+#include <cassert>
+#include <utility>
+
+namespace Mix {
+
+	template <typename Time>
+	typename BasicEventScheduler<Time>::Handle BasicEventScheduler<Time>::Schedule(uint64_t id, Time stopTime)
+	{
+		Handle handle;
+
+		// reuse a handle from a previous event if possible
+		if (!m_FreeHandles.empty())
+		{
+			handle = m_FreeHandles.back();
+			m_FreeHandles.pop_back();
+		}
+		else
+		{
+			handle = static_cast<Handle>(m_Positions.size());
+			m_Positions.push_back(c_NotInHeap);
+		}
+
+		m_Positions[handle] = static_cast<uint32_t>(m_Heap.size());
+		m_Heap.push_back({ id, stopTime, handle });
+
+		SiftUp(m_Heap.size() - 1);
+
+		return handle;
+	}
+
+	template <typename Time>
+	void BasicEventScheduler<Time>::Reschedule(Handle handle, Time stopTime)
+	{
+		assert(IsScheduled(handle));
+
+		const size_t index = m_Positions[handle];
+		const Time previousTime = m_Heap[index].stopTime;
+
+		m_Heap[index].stopTime = stopTime;
+
+		// only one direction can be violated after a single key change
+		if (stopTime < previousTime) SiftUp(index);
+		else SiftDown(index);
+	}
+
+	template <typename Time>
+	void BasicEventScheduler<Time>::Cancel(Handle handle)
+	{
+		assert(IsScheduled(handle));
+
+		const size_t index = m_Positions[handle];
+		const size_t last = m_Heap.size() - 1;
+
+		if (index != last)
+		{
+			Swap(index, last);
+		}
+
+		m_Heap.pop_back();
+		m_Positions[handle] = c_NotInHeap;
+		m_FreeHandles.push_back(handle);
+
+		// fix up the event that was moved into the removed slot
+		if (index < m_Heap.size())
+		{
+			SiftUp(index);
+			SiftDown(index);
+		}
+	}
+
+	template <typename Time>
+	bool BasicEventScheduler<Time>::IsScheduled(Handle handle) const
+	{
+		return handle < m_Positions.size() && m_Positions[handle] != c_NotInHeap;
+	}
+
+	template <typename Time>
+	const typename BasicEventScheduler<Time>::Event& BasicEventScheduler<Time>::Top() const
+	{
+		assert(!m_Heap.empty());
+
+		return m_Heap.front();
+	}
+
+	template <typename Time>
+	void BasicEventScheduler<Time>::Pop()
+	{
+		Cancel(Top().handle);
+	}
+
+	template <typename Time>
+	bool BasicEventScheduler<Time>::Empty() const
+	{
+		return m_Heap.empty();
+	}
+
+	template <typename Time>
+	size_t BasicEventScheduler<Time>::Size() const
+	{
+		return m_Heap.size();
+	}
+
+	template <typename Time>
+	void BasicEventScheduler<Time>::SiftUp(size_t index)
+	{
+		while (index > 0)
+		{
+			const size_t parent = (index - 1) / 2;
+
+			if (!(m_Heap[index].stopTime < m_Heap[parent].stopTime)) break;
+
+			Swap(index, parent);
+			index = parent;
+		}
+	}
+
+	template <typename Time>
+	void BasicEventScheduler<Time>::SiftDown(size_t index)
+	{
+		const size_t size = m_Heap.size();
+
+		while (true)
+		{
+			const size_t left = index * 2 + 1;
+			const size_t right = left + 1;
+			size_t smallest = index;
+
+			if (left < size && m_Heap[left].stopTime < m_Heap[smallest].stopTime) smallest = left;
+			if (right < size && m_Heap[right].stopTime < m_Heap[smallest].stopTime) smallest = right;
+
+			if (smallest == index) break;
+
+			Swap(index, smallest);
+			index = smallest;
+		}
+	}
+
+	template <typename Time>
+	void BasicEventScheduler<Time>::Swap(size_t lhs, size_t rhs)
+	{
+		std::swap(m_Heap[lhs], m_Heap[rhs]);
+
+		m_Positions[m_Heap[lhs].handle] = static_cast<uint32_t>(lhs);
+		m_Positions[m_Heap[rhs].handle] = static_cast<uint32_t>(rhs);
+	}
+
+	template class BasicEventScheduler<uint64_t>;
+	template class BasicEventScheduler<double>;
+
+} // Mix
\ No newline at end of file
@@ -0,0 +1,57 @@
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include <limits>
+#include <vector>
+
+namespace Mix {
+
+	/**
+	 * Indexed binary min-heap of audio deadlines
+	 * The earliest stop time is always at the top, and every scheduled event can be moved or cancelled
+	 * in O(log n) through the stable handle returned by Schedule
+	 * Only instantiated for engine ticks and floating point ranking keys
+	 */
+	template <typename Time>
+	class BasicEventScheduler
+	{
+	 public:
+		using Handle = uint32_t;
+		static constexpr Handle c_InvalidHandle = std::numeric_limits<Handle>::max();
+
+		struct Event
+		{
+			uint64_t id = 0; // whatever the owner uses to find the voice again
+			Time stopTime = 0;
+			Handle handle = c_InvalidHandle;
+		};
+
+		Handle Schedule(uint64_t id, Time stopTime);
+		void Reschedule(Handle handle, Time stopTime);
+		void Cancel(Handle handle);
+
+		bool IsScheduled(Handle handle) const;
+		const Event& Top() const;
+		void Pop();
+
+		bool Empty() const;
+		size_t Size() const;
+
+	 private:
+		void SiftUp(size_t index);
+		void SiftDown(size_t index);
+		void Swap(size_t lhs, size_t rhs);
+
+	 private:
+		static constexpr uint32_t c_NotInHeap = std::numeric_limits<uint32_t>::max();
+
+		std::vector<Event> m_Heap;
+		std::vector<uint32_t> m_Positions; // handle -> index into m_Heap
+		std::vector<Handle> m_FreeHandles;
+	};
+
+	using EventScheduler = BasicEventScheduler<uint64_t>; // keyed by engine tick
+	using RankScheduler = BasicEventScheduler<double>;
+
+} // Mix
\ No newline at end of file
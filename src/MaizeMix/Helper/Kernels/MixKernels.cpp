@@ -0,0 +1,72 @@
+#include "MaizeMix/Helper/Kernels/MixKernels.h"
+
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+	#include <intrin.h>
+#endif
+
+namespace Mix {
+
+	namespace {
+
+		bool SupportsAVX2()
+		{
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+			int registers[4];
+			__cpuid(registers, 0);
+
+			if (registers[0] < 7) return false;
+
+			// the os also has to save the upper halves of the registers
+			__cpuid(registers, 1);
+
+			const bool osSavesAVX = (registers[2] & (1 << 27)) && (registers[2] & (1 << 28)) && (_xgetbv(0) & 0x6) == 0x6;
+
+			__cpuidex(registers, 7, 0);
+
+			return osSavesAVX && (registers[1] & (1 << 5));
+#elif defined(__x86_64__) || defined(__i386__)
+			__builtin_cpu_init();
+
+			return __builtin_cpu_supports("avx2");
+#else
+			return false;
+#endif
+		}
+
+		InstructionSet FindInstructionSet()
+		{
+			if (GetAVX2Kernels() != nullptr && SupportsAVX2()) return InstructionSet::AVX2;
+			if (GetSSE2Kernels() != nullptr) return InstructionSet::SSE2; // always there on x86-64
+			if (GetNEONKernels() != nullptr) return InstructionSet::NEON; // always there on arm64
+
+			return InstructionSet::Scalar;
+		}
+
+	}
+
+	const MixKernels& GetMixKernels()
+	{
+		static const MixKernels& kernels = *GetMixKernels(GetMixInstructionSet());
+
+		return kernels;
+	}
+
+	const MixKernels* GetMixKernels(InstructionSet instructionSet)
+	{
+		switch (instructionSet)
+		{
+			case InstructionSet::SSE2: return GetSSE2Kernels();
+			case InstructionSet::AVX2: return SupportsAVX2() ? GetAVX2Kernels() : nullptr;
+			case InstructionSet::NEON: return GetNEONKernels();
+			default: return GetScalarKernels();
+		}
+	}
+
+	InstructionSet GetMixInstructionSet()
+	{
+		static const InstructionSet instructionSet = FindInstructionSet();
+
+		return instructionSet;
+	}
+
+} // Mix
\ No newline at end of file
@@ -0,0 +1,51 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace Mix {
+
+	enum class InstructionSet : uint8_t { Scalar = 0, SSE2, AVX2, NEON };
+
+	/**
+	 * Block processing used by the software mixer, every instruction set fills in the same table
+	 * Samples are kept in planar float buffers between the int16 clip data and the int16 output
+	 */
+	struct MixKernels
+	{
+		// int16 samples to floats in [-1, 1)
+		void (*ConvertToFloat)(float* output, const int16_t* input, size_t count);
+
+		// interleaved stereo int16 frames to a float plane for each channel
+		void (*DeinterleaveToFloat)(float* left, float* right, const int16_t* input, size_t frames);
+
+		// output[i] is read from input at position + step * i, the input must hold every frame touched
+		// (the one after for linear, and the one before and two after for cubic)
+		void (*ResampleLinear)(float* output, const float* input, size_t count, float position, float step);
+		void (*ResampleCubic)(float* output, const float* input, size_t count, float position, float step);
+
+		// output[i] += input[i] * (gain + ramp * i)
+		void (*MixGain)(float* output, const float* input, size_t count, float gain, float ramp);
+
+		// a mono plane into both stereo planes, each with its own gain ramp
+		void (*MixPanned)(float* left, float* right, const float* input, size_t count, float gainLeft, float gainRight, float rampLeft, float rampRight);
+
+		// clamps two float planes into interleaved stereo int16 frames
+		void (*InterleaveToInt16)(int16_t* output, const float* left, const float* right, size_t frames);
+	};
+
+	// the fastest kernels this cpu supports, picked the first time it is called
+	const MixKernels& GetMixKernels();
+
+	// null if the instruction set isn't built for this platform or isn't supported by this cpu
+	const MixKernels* GetMixKernels(InstructionSet instructionSet);
+
+	InstructionSet GetMixInstructionSet();
+
+	// implemented per instruction set, each returns null when it isn't built for this platform
+	const MixKernels* GetScalarKernels();
+	const MixKernels* GetSSE2Kernels();
+	const MixKernels* GetAVX2Kernels();
+	const MixKernels* GetNEONKernels();
+
+} // Mix
\ No newline at end of file
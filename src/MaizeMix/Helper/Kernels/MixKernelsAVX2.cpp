@@ -0,0 +1,239 @@
+#include "MaizeMix/Helper/Kernels/MixKernels.h"
+
+// only the kernels below are compiled for avx2, and only called once the cpu is known to support it
+// the file itself is built for the baseline so the inline helpers and std templates it shares with the rest stay baseline too
+#if (defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)) && (defined(__GNUC__) || defined(_MSC_VER))
+	#define MIX_KERNELS_AVX2
+#endif
+
+#if defined(MIX_KERNELS_AVX2)
+
+#include "MaizeMix/Helper/Kernels/ScalarKernels.h"
+
+#include <immintrin.h>
+
+// msvc allows avx2 intrinsics anywhere, gcc and clang only in functions that target it
+#if defined(_MSC_VER) && !defined(__clang__)
+	#define MIX_TARGET_AVX2
+#else
+	#define MIX_TARGET_AVX2 __attribute__((target("avx2")))
+#endif
+
+namespace Mix {
+
+	namespace {
+
+		MIX_TARGET_AVX2 __m256 Lanes(size_t i)
+		{
+			const auto first = static_cast<float>(i);
+
+			return _mm256_setr_ps(first, first + 1.0f, first + 2.0f, first + 3.0f, first + 4.0f, first + 5.0f, first + 6.0f, first + 7.0f);
+		}
+
+		MIX_TARGET_AVX2 void ConvertToFloat(float* output, const int16_t* input, size_t count)
+		{
+			const __m256 scale = _mm256_set1_ps(ScalarKernels::c_ToFloat);
+			size_t i = 0;
+
+			for (; i + 8 <= count; i += 8)
+			{
+				const __m256i samples = _mm256_cvtepi16_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(input + i)));
+
+				_mm256_storeu_ps(output + i, _mm256_mul_ps(_mm256_cvtepi32_ps(samples), scale));
+			}
+
+			for (; i < count; i++)
+			{
+				output[i] = static_cast<float>(input[i]) * ScalarKernels::c_ToFloat;
+			}
+		}
+
+		MIX_TARGET_AVX2 void DeinterleaveToFloat(float* left, float* right, const int16_t* input, size_t frames)
+		{
+			const __m256 scale = _mm256_set1_ps(ScalarKernels::c_ToFloat);
+			size_t i = 0;
+
+			for (; i + 8 <= frames; i += 8)
+			{
+				const __m256i samples = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(input + i * 2));
+
+				// left samples are the low half of each 32 bit frame, right samples the high half
+				const __m256i leftSamples = _mm256_srai_epi32(_mm256_slli_epi32(samples, 16), 16);
+				const __m256i rightSamples = _mm256_srai_epi32(samples, 16);
+
+				_mm256_storeu_ps(left + i, _mm256_mul_ps(_mm256_cvtepi32_ps(leftSamples), scale));
+				_mm256_storeu_ps(right + i, _mm256_mul_ps(_mm256_cvtepi32_ps(rightSamples), scale));
+			}
+
+			for (; i < frames; i++)
+			{
+				left[i] = static_cast<float>(input[i * 2]) * ScalarKernels::c_ToFloat;
+				right[i] = static_cast<float>(input[i * 2 + 1]) * ScalarKernels::c_ToFloat;
+			}
+		}
+
+		MIX_TARGET_AVX2 void ResampleLinear(float* output, const float* input, size_t count, float position, float step)
+		{
+			const __m256 start = _mm256_set1_ps(position);
+			const __m256 increment = _mm256_set1_ps(step);
+			size_t i = 0;
+
+			for (; i + 8 <= count; i += 8)
+			{
+				const __m256 at = _mm256_add_ps(start, _mm256_mul_ps(increment, Lanes(i)));
+				const __m256i indices = _mm256_cvttps_epi32(at);
+				const __m256 t = _mm256_sub_ps(at, _mm256_cvtepi32_ps(indices));
+
+				const __m256 current = _mm256_i32gather_ps(input, indices, 4);
+				const __m256 next = _mm256_i32gather_ps(input + 1, indices, 4);
+
+				_mm256_storeu_ps(output + i, _mm256_add_ps(current, _mm256_mul_ps(_mm256_sub_ps(next, current), t)));
+			}
+
+			for (; i < count; i++)
+			{
+				output[i] = ScalarKernels::ResampleLinear(input, position, step, i);
+			}
+		}
+
+		MIX_TARGET_AVX2 void ResampleCubic(float* output, const float* input, size_t count, float position, float step)
+		{
+			const __m256 start = _mm256_set1_ps(position);
+			const __m256 increment = _mm256_set1_ps(step);
+			const __m256 half = _mm256_set1_ps(0.5f);
+			const __m256 oneHalf = _mm256_set1_ps(1.5f);
+			const __m256 two = _mm256_set1_ps(2.0f);
+			const __m256 twoHalf = _mm256_set1_ps(2.5f);
+			size_t i = 0;
+
+			for (; i + 8 <= count; i += 8)
+			{
+				const __m256 at = _mm256_add_ps(start, _mm256_mul_ps(increment, Lanes(i)));
+				const __m256i indices = _mm256_cvttps_epi32(at);
+				const __m256 t = _mm256_sub_ps(at, _mm256_cvtepi32_ps(indices));
+
+				const __m256 p0 = _mm256_i32gather_ps(input - 1, indices, 4);
+				const __m256 p1 = _mm256_i32gather_ps(input, indices, 4);
+				const __m256 p2 = _mm256_i32gather_ps(input + 1, indices, 4);
+				const __m256 p3 = _mm256_i32gather_ps(input + 2, indices, 4);
+
+				const __m256 a = _mm256_add_ps(_mm256_mul_ps(_mm256_sub_ps(p3, p0), half), _mm256_mul_ps(_mm256_sub_ps(p1, p2), oneHalf));
+				const __m256 b = _mm256_sub_ps(_mm256_add_ps(_mm256_sub_ps(p0, _mm256_mul_ps(p1, twoHalf)), _mm256_mul_ps(p2, two)), _mm256_mul_ps(p3, half));
+				const __m256 c = _mm256_mul_ps(_mm256_sub_ps(p2, p0), half);
+
+				const __m256 result = _mm256_add_ps(_mm256_mul_ps(_mm256_add_ps(_mm256_mul_ps(_mm256_add_ps(_mm256_mul_ps(a, t), b), t), c), t), p1);
+
+				_mm256_storeu_ps(output + i, result);
+			}
+
+			for (; i < count; i++)
+			{
+				output[i] = ScalarKernels::ResampleCubic(input, position, step, i);
+			}
+		}
+
+		MIX_TARGET_AVX2 void MixGain(float* output, const float* input, size_t count, float gain, float ramp)
+		{
+			const __m256 start = _mm256_set1_ps(gain);
+			const __m256 increment = _mm256_set1_ps(ramp);
+			size_t i = 0;
+
+			for (; i + 8 <= count; i += 8)
+			{
+				const __m256 gains = _mm256_add_ps(start, _mm256_mul_ps(increment, Lanes(i)));
+				const __m256 mixed = _mm256_add_ps(_mm256_loadu_ps(output + i), _mm256_mul_ps(_mm256_loadu_ps(input + i), gains));
+
+				_mm256_storeu_ps(output + i, mixed);
+			}
+
+			for (; i < count; i++)
+			{
+				output[i] += input[i] * ScalarKernels::Gain(gain, ramp, i);
+			}
+		}
+
+		MIX_TARGET_AVX2 void MixPanned(float* left, float* right, const float* input, size_t count, float gainLeft, float gainRight, float rampLeft, float rampRight)
+		{
+			const __m256 startLeft = _mm256_set1_ps(gainLeft);
+			const __m256 startRight = _mm256_set1_ps(gainRight);
+			const __m256 incrementLeft = _mm256_set1_ps(rampLeft);
+			const __m256 incrementRight = _mm256_set1_ps(rampRight);
+			size_t i = 0;
+
+			for (; i + 8 <= count; i += 8)
+			{
+				const __m256 lanes = Lanes(i);
+				const __m256 samples = _mm256_loadu_ps(input + i);
+				const __m256 gainsLeft = _mm256_add_ps(startLeft, _mm256_mul_ps(incrementLeft, lanes));
+				const __m256 gainsRight = _mm256_add_ps(startRight, _mm256_mul_ps(incrementRight, lanes));
+
+				_mm256_storeu_ps(left + i, _mm256_add_ps(_mm256_loadu_ps(left + i), _mm256_mul_ps(samples, gainsLeft)));
+				_mm256_storeu_ps(right + i, _mm256_add_ps(_mm256_loadu_ps(right + i), _mm256_mul_ps(samples, gainsRight)));
+			}
+
+			for (; i < count; i++)
+			{
+				left[i] += input[i] * ScalarKernels::Gain(gainLeft, rampLeft, i);
+				right[i] += input[i] * ScalarKernels::Gain(gainRight, rampRight, i);
+			}
+		}
+
+		MIX_TARGET_AVX2 void InterleaveToInt16(int16_t* output, const float* left, const float* right, size_t frames)
+		{
+			const __m256 minimum = _mm256_set1_ps(-1.0f);
+			const __m256 maximum = _mm256_set1_ps(1.0f);
+			const __m256 scale = _mm256_set1_ps(ScalarKernels::c_ToInt16);
+			size_t i = 0;
+
+			for (; i + 8 <= frames; i += 8)
+			{
+				const __m256 leftSamples = _mm256_mul_ps(_mm256_min_ps(_mm256_max_ps(_mm256_loadu_ps(left + i), minimum), maximum), scale);
+				const __m256 rightSamples = _mm256_mul_ps(_mm256_min_ps(_mm256_max_ps(_mm256_loadu_ps(right + i), minimum), maximum), scale);
+
+				// unpacking and packing work within each 128 bit half, which happens to leave the frames in order
+				const __m256i leftIntegers = _mm256_cvtps_epi32(leftSamples);
+				const __m256i rightIntegers = _mm256_cvtps_epi32(rightSamples);
+				const __m256i low = _mm256_unpacklo_epi32(leftIntegers, rightIntegers);
+				const __m256i high = _mm256_unpackhi_epi32(leftIntegers, rightIntegers);
+
+				_mm256_storeu_si256(reinterpret_cast<__m256i*>(output + i * 2), _mm256_packs_epi32(low, high));
+			}
+
+			for (; i < frames; i++)
+			{
+				output[i * 2] = ScalarKernels::ToInt16(left[i]);
+				output[i * 2 + 1] = ScalarKernels::ToInt16(right[i]);
+			}
+		}
+
+	}
+
+	const MixKernels* GetAVX2Kernels()
+	{
+		static constexpr MixKernels kernels = {
+			ConvertToFloat,
+			DeinterleaveToFloat,
+			ResampleLinear,
+			ResampleCubic,
+			MixGain,
+			MixPanned,
+			InterleaveToInt16
+		};
+
+		return &kernels;
+	}
+
+} // Mix
+
+#else
+
+namespace Mix {
+
+	const MixKernels* GetAVX2Kernels()
+	{
+		return nullptr;
+	}
+
+} // Mix
+
+#endif
\ No newline at end of file
@@ -0,0 +1,239 @@
+#include "MaizeMix/Helper/Kernels/MixKernels.h"
+
+// neon is always there on 64 bit arm, 32 bit arm is left to the scalar kernels
+#if defined(__aarch64__) || defined(_M_ARM64)
+	#define MIX_KERNELS_NEON
+#endif
+
+#if defined(MIX_KERNELS_NEON)
+
+#include "MaizeMix/Helper/Kernels/ScalarKernels.h"
+
+#include <arm_neon.h>
+
+namespace Mix {
+
+	namespace {
+
+		// neon has no gather, so each lane is loaded on its own and only the math is vectorized
+		float32x4_t Gather(const float* input, int32x4_t indices, int32_t offset)
+		{
+			float32x4_t result = vdupq_n_f32(input[vgetq_lane_s32(indices, 0) + offset]);
+
+			result = vsetq_lane_f32(input[vgetq_lane_s32(indices, 1) + offset], result, 1);
+			result = vsetq_lane_f32(input[vgetq_lane_s32(indices, 2) + offset], result, 2);
+			result = vsetq_lane_f32(input[vgetq_lane_s32(indices, 3) + offset], result, 3);
+
+			return result;
+		}
+
+		float32x4_t Lanes(size_t i)
+		{
+			const auto first = static_cast<float>(i);
+			const float lanes[4] = { first, first + 1.0f, first + 2.0f, first + 3.0f };
+
+			return vld1q_f32(lanes);
+		}
+
+		void ConvertToFloat(float* output, const int16_t* input, size_t count)
+		{
+			const float32x4_t scale = vdupq_n_f32(ScalarKernels::c_ToFloat);
+			size_t i = 0;
+
+			for (; i + 8 <= count; i += 8)
+			{
+				const int16x8_t samples = vld1q_s16(input + i);
+
+				vst1q_f32(output + i, vmulq_f32(vcvtq_f32_s32(vmovl_s16(vget_low_s16(samples))), scale));
+				vst1q_f32(output + i + 4, vmulq_f32(vcvtq_f32_s32(vmovl_s16(vget_high_s16(samples))), scale));
+			}
+
+			for (; i < count; i++)
+			{
+				output[i] = static_cast<float>(input[i]) * ScalarKernels::c_ToFloat;
+			}
+		}
+
+		void DeinterleaveToFloat(float* left, float* right, const int16_t* input, size_t frames)
+		{
+			const float32x4_t scale = vdupq_n_f32(ScalarKernels::c_ToFloat);
+			size_t i = 0;
+
+			for (; i + 4 <= frames; i += 4)
+			{
+				const int16x4x2_t samples = vld2_s16(input + i * 2);
+
+				vst1q_f32(left + i, vmulq_f32(vcvtq_f32_s32(vmovl_s16(samples.val[0])), scale));
+				vst1q_f32(right + i, vmulq_f32(vcvtq_f32_s32(vmovl_s16(samples.val[1])), scale));
+			}
+
+			for (; i < frames; i++)
+			{
+				left[i] = static_cast<float>(input[i * 2]) * ScalarKernels::c_ToFloat;
+				right[i] = static_cast<float>(input[i * 2 + 1]) * ScalarKernels::c_ToFloat;
+			}
+		}
+
+		void ResampleLinear(float* output, const float* input, size_t count, float position, float step)
+		{
+			const float32x4_t start = vdupq_n_f32(position);
+			const float32x4_t increment = vdupq_n_f32(step);
+			size_t i = 0;
+
+			for (; i + 4 <= count; i += 4)
+			{
+				const float32x4_t at = vaddq_f32(start, vmulq_f32(increment, Lanes(i)));
+				const int32x4_t indices = vcvtq_s32_f32(at);
+				const float32x4_t t = vsubq_f32(at, vcvtq_f32_s32(indices));
+
+				const float32x4_t current = Gather(input, indices, 0);
+				const float32x4_t next = Gather(input, indices, 1);
+
+				vst1q_f32(output + i, vaddq_f32(current, vmulq_f32(vsubq_f32(next, current), t)));
+			}
+
+			for (; i < count; i++)
+			{
+				output[i] = ScalarKernels::ResampleLinear(input, position, step, i);
+			}
+		}
+
+		void ResampleCubic(float* output, const float* input, size_t count, float position, float step)
+		{
+			const float32x4_t start = vdupq_n_f32(position);
+			const float32x4_t increment = vdupq_n_f32(step);
+			const float32x4_t half = vdupq_n_f32(0.5f);
+			const float32x4_t oneHalf = vdupq_n_f32(1.5f);
+			const float32x4_t two = vdupq_n_f32(2.0f);
+			const float32x4_t twoHalf = vdupq_n_f32(2.5f);
+			size_t i = 0;
+
+			for (; i + 4 <= count; i += 4)
+			{
+				const float32x4_t at = vaddq_f32(start, vmulq_f32(increment, Lanes(i)));
+				const int32x4_t indices = vcvtq_s32_f32(at);
+				const float32x4_t t = vsubq_f32(at, vcvtq_f32_s32(indices));
+
+				const float32x4_t p0 = Gather(input, indices, -1);
+				const float32x4_t p1 = Gather(input, indices, 0);
+				const float32x4_t p2 = Gather(input, indices, 1);
+				const float32x4_t p3 = Gather(input, indices, 2);
+
+				const float32x4_t a = vaddq_f32(vmulq_f32(vsubq_f32(p3, p0), half), vmulq_f32(vsubq_f32(p1, p2), oneHalf));
+				const float32x4_t b = vsubq_f32(vaddq_f32(vsubq_f32(p0, vmulq_f32(p1, twoHalf)), vmulq_f32(p2, two)), vmulq_f32(p3, half));
+				const float32x4_t c = vmulq_f32(vsubq_f32(p2, p0), half);
+
+				const float32x4_t result = vaddq_f32(vmulq_f32(vaddq_f32(vmulq_f32(vaddq_f32(vmulq_f32(a, t), b), t), c), t), p1);
+
+				vst1q_f32(output + i, result);
+			}
+
+			for (; i < count; i++)
+			{
+				output[i] = ScalarKernels::ResampleCubic(input, position, step, i);
+			}
+		}
+
+		void MixGain(float* output, const float* input, size_t count, float gain, float ramp)
+		{
+			const float32x4_t start = vdupq_n_f32(gain);
+			const float32x4_t increment = vdupq_n_f32(ramp);
+			size_t i = 0;
+
+			for (; i + 4 <= count; i += 4)
+			{
+				const float32x4_t gains = vaddq_f32(start, vmulq_f32(increment, Lanes(i)));
+
+				vst1q_f32(output + i, vaddq_f32(vld1q_f32(output + i), vmulq_f32(vld1q_f32(input + i), gains)));
+			}
+
+			for (; i < count; i++)
+			{
+				output[i] += input[i] * ScalarKernels::Gain(gain, ramp, i);
+			}
+		}
+
+		void MixPanned(float* left, float* right, const float* input, size_t count, float gainLeft, float gainRight, float rampLeft, float rampRight)
+		{
+			const float32x4_t startLeft = vdupq_n_f32(gainLeft);
+			const float32x4_t startRight = vdupq_n_f32(gainRight);
+			const float32x4_t incrementLeft = vdupq_n_f32(rampLeft);
+			const float32x4_t incrementRight = vdupq_n_f32(rampRight);
+			size_t i = 0;
+
+			for (; i + 4 <= count; i += 4)
+			{
+				const float32x4_t lanes = Lanes(i);
+				const float32x4_t samples = vld1q_f32(input + i);
+				const float32x4_t gainsLeft = vaddq_f32(startLeft, vmulq_f32(incrementLeft, lanes));
+				const float32x4_t gainsRight = vaddq_f32(startRight, vmulq_f32(incrementRight, lanes));
+
+				vst1q_f32(left + i, vaddq_f32(vld1q_f32(left + i), vmulq_f32(samples, gainsLeft)));
+				vst1q_f32(right + i, vaddq_f32(vld1q_f32(right + i), vmulq_f32(samples, gainsRight)));
+			}
+
+			for (; i < count; i++)
+			{
+				left[i] += input[i] * ScalarKernels::Gain(gainLeft, rampLeft, i);
+				right[i] += input[i] * ScalarKernels::Gain(gainRight, rampRight, i);
+			}
+		}
+
+		void InterleaveToInt16(int16_t* output, const float* left, const float* right, size_t frames)
+		{
+			const float32x4_t minimum = vdupq_n_f32(-1.0f);
+			const float32x4_t maximum = vdupq_n_f32(1.0f);
+			const float32x4_t scale = vdupq_n_f32(ScalarKernels::c_ToInt16);
+			size_t i = 0;
+
+			for (; i + 4 <= frames; i += 4)
+			{
+				const float32x4_t leftSamples = vmulq_f32(vminq_f32(vmaxq_f32(vld1q_f32(left + i), minimum), maximum), scale);
+				const float32x4_t rightSamples = vmulq_f32(vminq_f32(vmaxq_f32(vld1q_f32(right + i), minimum), maximum), scale);
+
+				// rounds to nearest like lrint, then interleaving store
+				int16x4x2_t samples;
+				samples.val[0] = vqmovn_s32(vcvtnq_s32_f32(leftSamples));
+				samples.val[1] = vqmovn_s32(vcvtnq_s32_f32(rightSamples));
+
+				vst2_s16(output + i * 2, samples);
+			}
+
+			for (; i < frames; i++)
+			{
+				output[i * 2] = ScalarKernels::ToInt16(left[i]);
+				output[i * 2 + 1] = ScalarKernels::ToInt16(right[i]);
+			}
+		}
+
+	}
+
+	const MixKernels* GetNEONKernels()
+	{
+		static constexpr MixKernels kernels = {
+			ConvertToFloat,
+			DeinterleaveToFloat,
+			ResampleLinear,
+			ResampleCubic,
+			MixGain,
+			MixPanned,
+			InterleaveToInt16
+		};
+
+		return &kernels;
+	}
+
+} // Mix
+
+#else
+
+namespace Mix {
+
+	const MixKernels* GetNEONKernels()
+	{
+		return nullptr;
+	}
+
+} // Mix
+
+#endif
\ No newline at end of file
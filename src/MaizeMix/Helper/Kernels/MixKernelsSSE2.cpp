@@ -0,0 +1,244 @@
+#include "MaizeMix/Helper/Kernels/MixKernels.h"
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+	#define MIX_KERNELS_SSE2
+#endif
+
+#if defined(MIX_KERNELS_SSE2)
+
+#include "MaizeMix/Helper/Kernels/ScalarKernels.h"
+
+#include <emmintrin.h>
+
+namespace Mix {
+
+	namespace {
+
+		// sse2 has no gather, so each lane is loaded on its own and only the math is vectorized
+		__m128 Gather(const float* input, __m128i indices, int32_t offset)
+		{
+			alignas(16) int32_t lanes[4];
+			_mm_store_si128(reinterpret_cast<__m128i*>(lanes), indices);
+
+			return _mm_setr_ps(input[lanes[0] + offset], input[lanes[1] + offset], input[lanes[2] + offset], input[lanes[3] + offset]);
+		}
+
+		__m128 Lanes(size_t i)
+		{
+			const auto first = static_cast<float>(i);
+
+			return _mm_setr_ps(first, first + 1.0f, first + 2.0f, first + 3.0f);
+		}
+
+		void ConvertToFloat(float* output, const int16_t* input, size_t count)
+		{
+			const __m128 scale = _mm_set1_ps(ScalarKernels::c_ToFloat);
+			size_t i = 0;
+
+			for (; i + 8 <= count; i += 8)
+			{
+				const __m128i samples = _mm_loadu_si128(reinterpret_cast<const __m128i*>(input + i));
+
+				// sign extend by moving each sample into the top half and shifting it back down
+				const __m128i low = _mm_srai_epi32(_mm_unpacklo_epi16(samples, samples), 16);
+				const __m128i high = _mm_srai_epi32(_mm_unpackhi_epi16(samples, samples), 16);
+
+				_mm_storeu_ps(output + i, _mm_mul_ps(_mm_cvtepi32_ps(low), scale));
+				_mm_storeu_ps(output + i + 4, _mm_mul_ps(_mm_cvtepi32_ps(high), scale));
+			}
+
+			for (; i < count; i++)
+			{
+				output[i] = static_cast<float>(input[i]) * ScalarKernels::c_ToFloat;
+			}
+		}
+
+		void DeinterleaveToFloat(float* left, float* right, const int16_t* input, size_t frames)
+		{
+			const __m128 scale = _mm_set1_ps(ScalarKernels::c_ToFloat);
+			size_t i = 0;
+
+			for (; i + 4 <= frames; i += 4)
+			{
+				const __m128i samples = _mm_loadu_si128(reinterpret_cast<const __m128i*>(input + i * 2));
+
+				// left samples are the low half of each 32 bit frame, right samples the high half
+				const __m128i leftSamples = _mm_srai_epi32(_mm_slli_epi32(samples, 16), 16);
+				const __m128i rightSamples = _mm_srai_epi32(samples, 16);
+
+				_mm_storeu_ps(left + i, _mm_mul_ps(_mm_cvtepi32_ps(leftSamples), scale));
+				_mm_storeu_ps(right + i, _mm_mul_ps(_mm_cvtepi32_ps(rightSamples), scale));
+			}
+
+			for (; i < frames; i++)
+			{
+				left[i] = static_cast<float>(input[i * 2]) * ScalarKernels::c_ToFloat;
+				right[i] = static_cast<float>(input[i * 2 + 1]) * ScalarKernels::c_ToFloat;
+			}
+		}
+
+		void ResampleLinear(float* output, const float* input, size_t count, float position, float step)
+		{
+			const __m128 start = _mm_set1_ps(position);
+			const __m128 increment = _mm_set1_ps(step);
+			size_t i = 0;
+
+			for (; i + 4 <= count; i += 4)
+			{
+				const __m128 at = _mm_add_ps(start, _mm_mul_ps(increment, Lanes(i)));
+				const __m128i indices = _mm_cvttps_epi32(at);
+				const __m128 t = _mm_sub_ps(at, _mm_cvtepi32_ps(indices));
+
+				const __m128 current = Gather(input, indices, 0);
+				const __m128 next = Gather(input, indices, 1);
+
+				_mm_storeu_ps(output + i, _mm_add_ps(current, _mm_mul_ps(_mm_sub_ps(next, current), t)));
+			}
+
+			for (; i < count; i++)
+			{
+				output[i] = ScalarKernels::ResampleLinear(input, position, step, i);
+			}
+		}
+
+		void ResampleCubic(float* output, const float* input, size_t count, float position, float step)
+		{
+			const __m128 start = _mm_set1_ps(position);
+			const __m128 increment = _mm_set1_ps(step);
+			const __m128 half = _mm_set1_ps(0.5f);
+			const __m128 oneHalf = _mm_set1_ps(1.5f);
+			const __m128 two = _mm_set1_ps(2.0f);
+			const __m128 twoHalf = _mm_set1_ps(2.5f);
+			size_t i = 0;
+
+			for (; i + 4 <= count; i += 4)
+			{
+				const __m128 at = _mm_add_ps(start, _mm_mul_ps(increment, Lanes(i)));
+				const __m128i indices = _mm_cvttps_epi32(at);
+				const __m128 t = _mm_sub_ps(at, _mm_cvtepi32_ps(indices));
+
+				const __m128 p0 = Gather(input, indices, -1);
+				const __m128 p1 = Gather(input, indices, 0);
+				const __m128 p2 = Gather(input, indices, 1);
+				const __m128 p3 = Gather(input, indices, 2);
+
+				const __m128 a = _mm_add_ps(_mm_mul_ps(_mm_sub_ps(p3, p0), half), _mm_mul_ps(_mm_sub_ps(p1, p2), oneHalf));
+				const __m128 b = _mm_sub_ps(_mm_add_ps(_mm_sub_ps(p0, _mm_mul_ps(p1, twoHalf)), _mm_mul_ps(p2, two)), _mm_mul_ps(p3, half));
+				const __m128 c = _mm_mul_ps(_mm_sub_ps(p2, p0), half);
+
+				const __m128 result = _mm_add_ps(_mm_mul_ps(_mm_add_ps(_mm_mul_ps(_mm_add_ps(_mm_mul_ps(a, t), b), t), c), t), p1);
+
+				_mm_storeu_ps(output + i, result);
+			}
+
+			for (; i < count; i++)
+			{
+				output[i] = ScalarKernels::ResampleCubic(input, position, step, i);
+			}
+		}
+
+		void MixGain(float* output, const float* input, size_t count, float gain, float ramp)
+		{
+			const __m128 start = _mm_set1_ps(gain);
+			const __m128 increment = _mm_set1_ps(ramp);
+			size_t i = 0;
+
+			for (; i + 4 <= count; i += 4)
+			{
+				const __m128 gains = _mm_add_ps(start, _mm_mul_ps(increment, Lanes(i)));
+				const __m128 mixed = _mm_add_ps(_mm_loadu_ps(output + i), _mm_mul_ps(_mm_loadu_ps(input + i), gains));
+
+				_mm_storeu_ps(output + i, mixed);
+			}
+
+			for (; i < count; i++)
+			{
+				output[i] += input[i] * ScalarKernels::Gain(gain, ramp, i);
+			}
+		}
+
+		void MixPanned(float* left, float* right, const float* input, size_t count, float gainLeft, float gainRight, float rampLeft, float rampRight)
+		{
+			const __m128 startLeft = _mm_set1_ps(gainLeft);
+			const __m128 startRight = _mm_set1_ps(gainRight);
+			const __m128 incrementLeft = _mm_set1_ps(rampLeft);
+			const __m128 incrementRight = _mm_set1_ps(rampRight);
+			size_t i = 0;
+
+			for (; i + 4 <= count; i += 4)
+			{
+				const __m128 lanes = Lanes(i);
+				const __m128 samples = _mm_loadu_ps(input + i);
+				const __m128 gainsLeft = _mm_add_ps(startLeft, _mm_mul_ps(incrementLeft, lanes));
+				const __m128 gainsRight = _mm_add_ps(startRight, _mm_mul_ps(incrementRight, lanes));
+
+				_mm_storeu_ps(left + i, _mm_add_ps(_mm_loadu_ps(left + i), _mm_mul_ps(samples, gainsLeft)));
+				_mm_storeu_ps(right + i, _mm_add_ps(_mm_loadu_ps(right + i), _mm_mul_ps(samples, gainsRight)));
+			}
+
+			for (; i < count; i++)
+			{
+				left[i] += input[i] * ScalarKernels::Gain(gainLeft, rampLeft, i);
+				right[i] += input[i] * ScalarKernels::Gain(gainRight, rampRight, i);
+			}
+		}
+
+		void InterleaveToInt16(int16_t* output, const float* left, const float* right, size_t frames)
+		{
+			const __m128 minimum = _mm_set1_ps(-1.0f);
+			const __m128 maximum = _mm_set1_ps(1.0f);
+			const __m128 scale = _mm_set1_ps(ScalarKernels::c_ToInt16);
+			size_t i = 0;
+
+			for (; i + 4 <= frames; i += 4)
+			{
+				const __m128 leftSamples = _mm_mul_ps(_mm_min_ps(_mm_max_ps(_mm_loadu_ps(left + i), minimum), maximum), scale);
+				const __m128 rightSamples = _mm_mul_ps(_mm_min_ps(_mm_max_ps(_mm_loadu_ps(right + i), minimum), maximum), scale);
+
+				// rounds to nearest like lrint, then interleave as 32 bit pairs before packing down to 16 bits
+				const __m128i leftIntegers = _mm_cvtps_epi32(leftSamples);
+				const __m128i rightIntegers = _mm_cvtps_epi32(rightSamples);
+				const __m128i low = _mm_unpacklo_epi32(leftIntegers, rightIntegers);
+				const __m128i high = _mm_unpackhi_epi32(leftIntegers, rightIntegers);
+
+				_mm_storeu_si128(reinterpret_cast<__m128i*>(output + i * 2), _mm_packs_epi32(low, high));
+			}
+
+			for (; i < frames; i++)
+			{
+				output[i * 2] = ScalarKernels::ToInt16(left[i]);
+				output[i * 2 + 1] = ScalarKernels::ToInt16(right[i]);
+			}
+		}
+
+	}
+
+	const MixKernels* GetSSE2Kernels()
+	{
+		static constexpr MixKernels kernels = {
+			ConvertToFloat,
+			DeinterleaveToFloat,
+			ResampleLinear,
+			ResampleCubic,
+			MixGain,
+			MixPanned,
+			InterleaveToInt16
+		};
+
+		return &kernels;
+	}
+
+} // Mix
+
+#else
+
+namespace Mix {
+
+	const MixKernels* GetSSE2Kernels()
+	{
+		return nullptr;
+	}
+
+} // Mix
+
+#endif
\ No newline at end of file
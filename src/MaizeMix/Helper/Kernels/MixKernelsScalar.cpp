@@ -0,0 +1,84 @@
+#include "MaizeMix/Helper/Kernels/MixKernels.h"
+#include "MaizeMix/Helper/Kernels/ScalarKernels.h"
+
+namespace Mix {
+
+	namespace {
+
+		void ConvertToFloat(float* output, const int16_t* input, size_t count)
+		{
+			for (size_t i = 0; i < count; i++)
+			{
+				output[i] = static_cast<float>(input[i]) * ScalarKernels::c_ToFloat;
+			}
+		}
+
+		void DeinterleaveToFloat(float* left, float* right, const int16_t* input, size_t frames)
+		{
+			for (size_t i = 0; i < frames; i++)
+			{
+				left[i] = static_cast<float>(input[i * 2]) * ScalarKernels::c_ToFloat;
+				right[i] = static_cast<float>(input[i * 2 + 1]) * ScalarKernels::c_ToFloat;
+			}
+		}
+
+		void ResampleLinear(float* output, const float* input, size_t count, float position, float step)
+		{
+			for (size_t i = 0; i < count; i++)
+			{
+				output[i] = ScalarKernels::ResampleLinear(input, position, step, i);
+			}
+		}
+
+		void ResampleCubic(float* output, const float* input, size_t count, float position, float step)
+		{
+			for (size_t i = 0; i < count; i++)
+			{
+				output[i] = ScalarKernels::ResampleCubic(input, position, step, i);
+			}
+		}
+
+		void MixGain(float* output, const float* input, size_t count, float gain, float ramp)
+		{
+			for (size_t i = 0; i < count; i++)
+			{
+				output[i] += input[i] * ScalarKernels::Gain(gain, ramp, i);
+			}
+		}
+
+		void MixPanned(float* left, float* right, const float* input, size_t count, float gainLeft, float gainRight, float rampLeft, float rampRight)
+		{
+			for (size_t i = 0; i < count; i++)
+			{
+				left[i] += input[i] * ScalarKernels::Gain(gainLeft, rampLeft, i);
+				right[i] += input[i] * ScalarKernels::Gain(gainRight, rampRight, i);
+			}
+		}
+
+		void InterleaveToInt16(int16_t* output, const float* left, const float* right, size_t frames)
+		{
+			for (size_t i = 0; i < frames; i++)
+			{
+				output[i * 2] = ScalarKernels::ToInt16(left[i]);
+				output[i * 2 + 1] = ScalarKernels::ToInt16(right[i]);
+			}
+		}
+
+	}
+
+	const MixKernels* GetScalarKernels()
+	{
+		static constexpr MixKernels kernels = {
+			ConvertToFloat,
+			DeinterleaveToFloat,
+			ResampleLinear,
+			ResampleCubic,
+			MixGain,
+			MixPanned,
+			InterleaveToInt16
+		};
+
+		return &kernels;
+	}
+
+} // Mix
\ No newline at end of file
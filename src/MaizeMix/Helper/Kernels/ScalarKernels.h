@@ -0,0 +1,54 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cmath>
+
+namespace Mix::ScalarKernels {
+
+	// single sample versions of the kernels, the vector kernels use them for the samples that don't fill a vector
+	// so every instruction set does the same math in the same order
+
+	constexpr float c_ToFloat = 1.0f / 32768.0f;
+	constexpr float c_ToInt16 = 32767.0f;
+
+	inline float ResampleLinear(const float* input, float position, float step, size_t i)
+	{
+		const float at = position + step * static_cast<float>(i);
+		const auto index = static_cast<int32_t>(at);
+		const float t = at - static_cast<float>(index);
+
+		return input[index] + (input[index + 1] - input[index]) * t;
+	}
+
+	inline float ResampleCubic(const float* input, float position, float step, size_t i)
+	{
+		const float at = position + step * static_cast<float>(i);
+		const auto index = static_cast<int32_t>(at);
+		const float t = at - static_cast<float>(index);
+
+		// catmull-rom spline through the two frames either side
+		const float p0 = input[index - 1];
+		const float p1 = input[index];
+		const float p2 = input[index + 1];
+		const float p3 = input[index + 2];
+
+		const float a = (p3 - p0) * 0.5f + (p1 - p2) * 1.5f;
+		const float b = p0 - p1 * 2.5f + p2 * 2.0f - p3 * 0.5f;
+		const float c = (p2 - p0) * 0.5f;
+
+		return ((a * t + b) * t + c) * t + p1;
+	}
+
+	inline float Gain(float gain, float ramp, size_t i)
+	{
+		return gain + ramp * static_cast<float>(i);
+	}
+
+	inline int16_t ToInt16(float sample)
+	{
+		return static_cast<int16_t>(std::lrint(std::clamp(sample, -1.0f, 1.0f) * c_ToInt16));
+	}
+
+} // Mix::ScalarKernels
\ No newline at end of file
@@ -0,0 +1,123 @@
+#include "MaizeMix/Helper/MappedFile.h"
+
+#if defined(_WIN32)
+	#define WIN32_LEAN_AND_MEAN
+	#define NOMINMAX
+	#include <windows.h>
+#else
+	#include <sys/mman.h>
+	#include <sys/stat.h>
+	#include <fcntl.h>
+	#include <unistd.h>
+#endif
+
+namespace Mix {
+
+	MappedFile::~MappedFile()
+	{
+		Close();
+	}
+
+#if defined(_WIN32)
+
+	bool MappedFile::Open(const std::string& filename)
+	{
+		Close();
+
+		const HANDLE file = CreateFileA(filename.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+
+		if (file == INVALID_HANDLE_VALUE) return false;
+
+		LARGE_INTEGER size;
+
+		// empty files can't be mapped
+		if (!GetFileSizeEx(file, &size) || size.QuadPart == 0)
+		{
+			CloseHandle(file);
+			return false;
+		}
+
+		const HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+
+		// the view keeps the mapping and file alive, so the handles aren't needed after this
+		if (mapping != nullptr)
+		{
+			m_Data = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+			CloseHandle(mapping);
+		}
+
+		CloseHandle(file);
+
+		if (m_Data == nullptr) return false;
+
+		m_Size = static_cast<size_t>(size.QuadPart);
+
+		return true;
+	}
+
+	void MappedFile::Close()
+	{
+		if (m_Data != nullptr) UnmapViewOfFile(m_Data);
+
+		m_Data = nullptr;
+		m_Size = 0;
+	}
+
+#else
+
+	bool MappedFile::Open(const std::string& filename)
+	{
+		Close();
+
+		const int file = open(filename.c_str(), O_RDONLY);
+
+		if (file == -1) return false;
+
+		struct stat status{};
+
+		// empty files can't be mapped
+		if (fstat(file, &status) == -1 || status.st_size == 0)
+		{
+			close(file);
+			return false;
+		}
+
+		void* data = mmap(nullptr, status.st_size, PROT_READ, MAP_PRIVATE, file, 0);
+
+		// the mapping keeps its own reference to the file
+		close(file);
+
+		if (data == MAP_FAILED) return false;
+
+		m_Data = data;
+		m_Size = static_cast<size_t>(status.st_size);
+
+		return true;
+	}
+
+	void MappedFile::Close()
+	{
+		if (m_Data != nullptr) munmap(const_cast<void*>(m_Data), m_Size);
+
+		m_Data = nullptr;
+		m_Size = 0;
+	}
+
+#endif
+
+	const void* MappedFile::GetData() const
+	{
+		return m_Data;
+	}
+
+	size_t MappedFile::GetSize() const
+	{
+		return m_Size;
+	}
+
+	bool MappedFile::IsOpen() const
+	{
+		return m_Data != nullptr;
+	}
+
+} // Mix
\ No newline at end of file
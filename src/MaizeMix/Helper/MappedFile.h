@@ -0,0 +1,33 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+
+namespace Mix {
+
+	/**
+	 * Read only view of a whole file mapped into memory
+	 * Pages are loaded by the os as they are touched, so opening it does not read the file
+	 */
+	class MappedFile
+	{
+	 public:
+		MappedFile() = default;
+		~MappedFile();
+
+		MappedFile(const MappedFile&) = delete;
+		MappedFile& operator=(const MappedFile&) = delete;
+
+		bool Open(const std::string& filename);
+		void Close();
+
+		const void* GetData() const;
+		size_t GetSize() const;
+		bool IsOpen() const;
+
+	 private:
+		const void* m_Data = nullptr;
+		size_t m_Size = 0;
+	};
+
+} // Mix
\ No newline at end of file
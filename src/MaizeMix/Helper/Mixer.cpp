@@ -0,0 +1,137 @@
+#include "MaizeMix/Helper/Mixer.h"
+
+#include <algorithm>
+
+namespace Mix {
+
+	Mixer::Mixer(uint32_t voiceCount, uint32_t sampleRate) :
+		m_Voices(voiceCount), m_Kernels(&GetMixKernels()), m_SampleRate(sampleRate),
+		m_SourceLeft(MixerVoice::c_WindowFrames), m_SourceRight(MixerVoice::c_WindowFrames)
+	{
+		for (auto& voice : m_Voices)
+		{
+			voice.m_Mixer = this;
+		}
+	}
+
+	VoicePool<MixerVoice>& Mixer::GetVoices()
+	{
+		return m_Voices;
+	}
+
+	const VoicePool<MixerVoice>& Mixer::GetVoices() const
+	{
+		return m_Voices;
+	}
+
+	void Mixer::SetListenerPosition(const sf::Vector3f& position)
+	{
+		std::lock_guard lock(m_Mutex);
+
+		m_ListenerPosition = position;
+	}
+
+	void Mixer::SetVolume(float volume)
+	{
+		std::lock_guard lock(m_Mutex);
+
+		m_Volume = volume / 100.0f;
+	}
+
+	void Mixer::SetBuses(const std::vector<Bus>& buses)
+	{
+		std::lock_guard lock(m_Mutex);
+
+		m_Buses = buses;
+	}
+
+	void Mixer::SetInterpolation(Interpolation interpolation)
+	{
+		std::lock_guard lock(m_Mutex);
+
+		m_Interpolation = interpolation;
+	}
+
+	void Mixer::SetKernels(const MixKernels& kernels)
+	{
+		std::lock_guard lock(m_Mutex);
+
+		m_Kernels = &kernels;
+	}
+
+	void Mixer::Mix(sf::Int16* output, size_t frames)
+	{
+		std::lock_guard lock(m_Mutex);
+		const sf::Clock clock;
+
+		// only grows the first time a block of this size is mixed
+		if (m_Left.size() < frames)
+		{
+			for (auto* plane : { &m_Left, &m_Right, &m_ResampledLeft, &m_ResampledRight })
+			{
+				plane->resize(frames);
+			}
+		}
+
+		std::fill_n(m_Left.begin(), frames, 0.0f);
+		std::fill_n(m_Right.begin(), frames, 0.0f);
+
+		const uint64_t blockStart = m_MixedFrames.load(std::memory_order_relaxed);
+		const uint64_t blockEnd = blockStart + frames;
+
+		for (auto& voice : m_Voices)
+		{
+			if (voice.m_Status != sf::SoundSource::Playing || voice.m_StartFrame >= blockEnd) continue;
+
+			const Bus bus = voice.m_Bus < m_Buses.size() ? m_Buses[voice.m_Bus] : Bus();
+
+			// held where it is, scheduled start and stop included
+			if (bus.isPaused) continue;
+
+			// scheduled voices can start or stop part way through the block
+			const size_t first = voice.m_StartFrame > blockStart ? static_cast<size_t>(voice.m_StartFrame - blockStart) : 0;
+			const size_t last = voice.m_StopFrame < blockEnd ? static_cast<size_t>(std::max(voice.m_StopFrame, blockStart) - blockStart) : frames;
+
+			if (last > first) voice.Render(*this, first, last - first, bus.gain);
+
+			if (voice.m_StopFrame <= blockEnd)
+			{
+				voice.m_Status = sf::SoundSource::Stopped;
+				voice.m_Offset = 0;
+			}
+		}
+
+		m_Kernels->InterleaveToInt16(output, m_Left.data(), m_Right.data(), frames);
+
+		m_MixTime.store(clock.getElapsedTime().asSeconds(), std::memory_order_relaxed);
+		m_MixedFrames.fetch_add(frames, std::memory_order_release);
+	}
+
+	uint32_t Mixer::GetSampleRate() const
+	{
+		return m_SampleRate;
+	}
+
+	float Mixer::GetMixTime() const
+	{
+		return m_MixTime.load(std::memory_order_relaxed);
+	}
+
+	uint64_t Mixer::GetMixedFrames() const
+	{
+		return m_MixedFrames.load(std::memory_order_acquire);
+	}
+
+	void Mixer::EnableStreamDecoding(size_t threadCount)
+	{
+		std::lock_guard lock(m_Mutex);
+
+		if (m_StreamDecoder == nullptr) m_StreamDecoder = std::make_unique<StreamDecoder>(threadCount);
+	}
+
+	const StreamDecoder* Mixer::GetStreamDecoder() const
+	{
+		return m_StreamDecoder.get();
+	}
+
+} // Mix
\ No newline at end of file
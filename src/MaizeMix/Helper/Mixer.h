@@ -0,0 +1,97 @@
+#pragma once
+
+#include <SFML/Audio.hpp>
+#include <cstdint>
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "MaizeMix/Helper/Kernels/MixKernels.h"
+#include "MaizeMix/Helper/StreamDecoder.h"
+#include "MaizeMix/Helper/MixerVoice.h"
+#include "MaizeMix/Helper/VoicePool.h"
+
+namespace Mix {
+
+	/**
+	 * Mixes every playing voice in software into a single interleaved stereo signal
+	 * Voices can be driven from the engine thread while another thread pulls mixed blocks
+	 */
+	class Mixer
+	{
+	 public:
+		enum class Interpolation { Linear = 0, Cubic };
+
+		// a bus of the engine with every bus above it folded in
+		struct Bus
+		{
+			float gain = 1.0f;
+			bool isPaused = false; // its voices keep their place without being mixed
+		};
+
+		explicit Mixer(uint32_t voiceCount, uint32_t sampleRate = c_DefaultSampleRate);
+
+		VoicePool<MixerVoice>& GetVoices();
+		const VoicePool<MixerVoice>& GetVoices() const;
+
+		void SetListenerPosition(const sf::Vector3f& position);
+
+		// master volume in [0, 100], applied to every voice
+		void SetVolume(float volume);
+
+		// replaces every bus at once, so a change reaches all of a bus's voices on the same block
+		void SetBuses(const std::vector<Bus>& buses);
+
+		// how pitched or resampled voices are read between frames
+		void SetInterpolation(Interpolation interpolation);
+
+		// defaults to the fastest kernels the cpu supports
+		void SetKernels(const MixKernels& kernels);
+
+		void Mix(sf::Int16* output, size_t frames);
+
+		uint32_t GetSampleRate() const;
+
+		// seconds the last block took to mix, safe to read from any thread
+		float GetMixTime() const;
+
+		// every frame mixed so far, safe to read from any thread
+		uint64_t GetMixedFrames() const;
+
+		// streamed voices are decoded ahead by these workers instead of while mixing, only takes effect for voices streamed after it
+		void EnableStreamDecoding(size_t threadCount);
+
+		// null unless stream decoding was enabled
+		const StreamDecoder* GetStreamDecoder() const;
+
+		static constexpr uint32_t c_ChannelCount = 2;
+		static constexpr uint32_t c_DefaultSampleRate = 44100;
+
+	 private:
+		friend class MixerVoice;
+
+		VoicePool<MixerVoice> m_Voices;
+		const MixKernels* m_Kernels = nullptr;
+		Interpolation m_Interpolation = Interpolation::Linear;
+		float m_Volume = 1.0f;
+		std::vector<Bus> m_Buses = { Bus() }; // voices on a bus past the end are mixed as if on the master bus
+		std::atomic<float> m_MixTime = 0;
+		std::atomic<uint64_t> m_MixedFrames = 0;
+		sf::Vector3f m_ListenerPosition;
+		uint32_t m_SampleRate = 0;
+
+		// mixed planes, and scratch space shared by every voice since they are mixed one after the other
+		std::vector<float> m_Left;
+		std::vector<float> m_Right;
+		std::vector<float> m_SourceLeft;
+		std::vector<float> m_SourceRight;
+		std::vector<float> m_ResampledLeft;
+		std::vector<float> m_ResampledRight;
+
+		std::mutex m_Mutex; // held while mixing a block, and by every voice change
+
+		std::unique_ptr<StreamDecoder> m_StreamDecoder; // stopped before the voices go away
+	};
+
+} // Mix
\ No newline at end of file
@@ -0,0 +1,32 @@
+#include "MaizeMix/Helper/MixerStream.h"
+#include "MaizeMix/Helper/Mixer.h"
+
+namespace Mix {
+
+	MixerStream::MixerStream(Mixer& mixer, size_t blockFrames) : m_Mixer(mixer), m_Samples(blockFrames * Mixer::c_ChannelCount)
+	{
+		initialize(Mixer::c_ChannelCount, mixer.GetSampleRate());
+	}
+
+	MixerStream::~MixerStream()
+	{
+		// the streaming thread has to be done with the mixer before it goes away
+		stop();
+	}
+
+	bool MixerStream::onGetData(Chunk& data)
+	{
+		m_Mixer.Mix(m_Samples.data(), m_Samples.size() / Mixer::c_ChannelCount);
+
+		data.samples = m_Samples.data();
+		data.sampleCount = m_Samples.size();
+
+		// never runs out, silence is mixed while nothing is playing
+		return true;
+	}
+
+	void MixerStream::onSeek(sf::Time)
+	{
+	}
+
+} // Mix
\ No newline at end of file
@@ -0,0 +1,30 @@
+#pragma once
+
+#include <SFML/Audio.hpp>
+#include <vector>
+
+namespace Mix {
+
+	class Mixer;
+
+	/**
+	 * Plays the output of a Mixer, so every voice shares one backend source and streaming thread
+	 */
+	class MixerStream final : public sf::SoundStream
+	{
+	 public:
+		explicit MixerStream(Mixer& mixer, size_t blockFrames = c_DefaultBlockFrames);
+		~MixerStream() override;
+
+		static constexpr size_t c_DefaultBlockFrames = 512;
+
+	 private:
+		bool onGetData(Chunk& data) override;
+		void onSeek(sf::Time timeOffset) override;
+
+	 private:
+		Mixer& m_Mixer;
+		std::vector<sf::Int16> m_Samples;
+	};
+
+} // Mix
\ No newline at end of file
@@ -0,0 +1,407 @@
+#include "MaizeMix/Helper/MixerVoice.h"
+#include "MaizeMix/Helper/Kernels/MixKernels.h"
+#include "MaizeMix/Helper/Mixer.h"
+#include "MaizeMix/Helper/AudioClips/SoundBuffer.h"
+#include "MaizeMix/Helper/AudioClips/StreamedClip.h"
+#include "MaizeMix/Helper/DecodeStream.h"
+
+#include <algorithm>
+#include <numbers>
+#include <cmath>
+
+namespace Mix {
+
+	void MixerVoice::setBuffer(const std::shared_ptr<const SoundBuffer>& buffer)
+	{
+		const auto& samples = buffer->GetBuffer();
+
+		std::lock_guard lock(m_Mixer->m_Mutex);
+
+		SetClip(buffer, samples.getChannelCount(), samples.getSampleRate(), samples.getSampleCount());
+		m_Buffer = buffer.get();
+	}
+
+	bool MixerVoice::setSoundReference(const std::shared_ptr<const StreamedClip>& clip)
+	{
+		// every voice needs its own decoder, but they all read the same encoded data
+		auto stream = std::make_shared<DecodeStream>();
+
+		if (!stream->Open(clip)) return false;
+
+		std::lock_guard lock(m_Mixer->m_Mutex);
+
+		SetClip(clip, clip->GetChannelCount(), clip->GetSampleRate(), clip->GetSampleCount());
+		stream->SetLoop(m_Loop);
+		m_Stream = std::move(stream);
+
+		if (m_Mixer->m_StreamDecoder != nullptr) m_Mixer->m_StreamDecoder->Add(m_Stream);
+
+		return true;
+	}
+
+	void MixerVoice::resetBuffer()
+	{
+		std::lock_guard lock(m_Mixer->m_Mutex);
+
+		Reset();
+	}
+
+	void MixerVoice::play()
+	{
+		std::lock_guard lock(m_Mixer->m_Mutex);
+
+		if (m_Clip.expired()) return;
+
+		// fade in over the first block rather than starting at full volume
+		if (m_Status == sf::SoundSource::Stopped)
+		{
+			m_GainLeft = 0;
+			m_GainRight = 0;
+		}
+
+		m_Status = sf::SoundSource::Playing;
+	}
+
+	void MixerVoice::pause()
+	{
+		std::lock_guard lock(m_Mixer->m_Mutex);
+
+		if (m_Status == sf::SoundSource::Playing) m_Status = sf::SoundSource::Paused;
+
+		// a pause gives up the scheduled start, it resumes as soon as it is played again
+		m_StartFrame = 0;
+	}
+
+	void MixerVoice::stop()
+	{
+		std::lock_guard lock(m_Mixer->m_Mutex);
+
+		m_Status = sf::SoundSource::Stopped;
+		m_Offset = 0;
+	}
+
+	sf::SoundSource::Status MixerVoice::getStatus() const
+	{
+		std::lock_guard lock(m_Mixer->m_Mutex);
+
+		return m_Status;
+	}
+
+	void MixerVoice::setLoop(bool loop)
+	{
+		std::lock_guard lock(m_Mixer->m_Mutex);
+
+		m_Loop = loop;
+
+		if (m_Stream != nullptr) m_Stream->SetLoop(loop);
+	}
+
+	void MixerVoice::setVolume(float volume)
+	{
+		std::lock_guard lock(m_Mixer->m_Mutex);
+
+		m_Volume = volume;
+	}
+
+	void MixerVoice::setPitch(float pitch)
+	{
+		std::lock_guard lock(m_Mixer->m_Mutex);
+
+		m_Pitch = pitch;
+	}
+
+	void MixerVoice::setPosition(const sf::Vector3f& position)
+	{
+		std::lock_guard lock(m_Mixer->m_Mutex);
+
+		m_Position = position;
+	}
+
+	void MixerVoice::setBus(uint32_t bus)
+	{
+		std::lock_guard lock(m_Mixer->m_Mutex);
+
+		m_Bus = bus;
+	}
+
+	void MixerVoice::setPlayingOffset(sf::Time timeOffset)
+	{
+		std::lock_guard lock(m_Mixer->m_Mutex);
+
+		const double offset = static_cast<double>(timeOffset.asSeconds()) * m_SampleRate;
+
+		m_Offset = std::clamp(offset, 0.0, static_cast<double>(m_FrameCount));
+		m_StartFrame = 0; // seeking also gives up a scheduled start
+	}
+
+	sf::Time MixerVoice::getPlayingOffset() const
+	{
+		std::lock_guard lock(m_Mixer->m_Mutex);
+
+		if (m_SampleRate == 0) return sf::Time::Zero;
+
+		return sf::seconds(static_cast<float>(m_Offset / m_SampleRate));
+	}
+
+	void MixerVoice::setStartFrame(uint64_t frame)
+	{
+		std::lock_guard lock(m_Mixer->m_Mutex);
+
+		m_StartFrame = frame;
+	}
+
+	void MixerVoice::setStopFrame(uint64_t frame)
+	{
+		std::lock_guard lock(m_Mixer->m_Mutex);
+
+		m_StopFrame = frame;
+	}
+
+	float MixerVoice::getBufferedTime() const
+	{
+		std::lock_guard lock(m_Mixer->m_Mutex);
+
+		return m_Stream != nullptr ? m_Stream->GetBufferedTime() : 0.0f;
+	}
+
+	uint32_t MixerVoice::getUnderruns() const
+	{
+		std::lock_guard lock(m_Mixer->m_Mutex);
+
+		return m_Stream != nullptr ? m_Stream->GetUnderruns() : 0;
+	}
+
+	void MixerVoice::Render(Mixer& mixer, size_t outputOffset, size_t frames, float busGain)
+	{
+		const auto clip = m_Clip.lock();
+
+		// the clip was removed while it was playing
+		if (clip == nullptr || m_FrameCount == 0)
+		{
+			Reset();
+			return;
+		}
+
+		float gainLeft = m_Volume / 100.0f * busGain * mixer.m_Volume;
+		float gainRight = gainLeft;
+
+		// like the backend, only mono clips are spatialized, with inverse distance attenuation and an equal power pan
+		if (m_ChannelCount == 1)
+		{
+			const float dx = m_Position.x - mixer.m_ListenerPosition.x;
+			const float dy = m_Position.y - mixer.m_ListenerPosition.y;
+			const float dz = m_Position.z - mixer.m_ListenerPosition.z;
+			const float distance = std::sqrt(dx * dx + dy * dy + dz * dz);
+			const float attenuation = 1.0f / std::max(distance, 1.0f);
+			const float pan = distance > 0.0f ? dx / distance : 0.0f;
+			const float angle = (pan + 1.0f) * 0.25f * std::numbers::pi_v<float>;
+
+			gainLeft *= attenuation * std::cos(angle);
+			gainRight *= attenuation * std::sin(angle);
+		}
+
+		const MixKernels& kernels = *mixer.m_Kernels;
+		const auto resample = mixer.m_Interpolation == Mixer::Interpolation::Cubic ? kernels.ResampleCubic : kernels.ResampleLinear;
+
+		const double step = static_cast<double>(m_Pitch) * m_SampleRate / mixer.m_SampleRate;
+		const float rampLeft = (gainLeft - m_GainLeft) / static_cast<float>(frames);
+		const float rampRight = (gainRight - m_GainRight) / static_cast<float>(frames);
+		const size_t windowLimit = std::max<size_t>(1, static_cast<size_t>((c_WindowFrames - c_WindowPadding) / step));
+
+		float* sourceLeft = mixer.m_SourceLeft.data();
+		float* sourceRight = mixer.m_SourceRight.data();
+		float* outputLeft = mixer.m_Left.data() + outputOffset;
+		float* outputRight = mixer.m_Right.data() + outputOffset;
+
+		for (size_t done = 0; done < frames;)
+		{
+			size_t count = std::min(frames - done, windowLimit);
+
+			// don't read past the end of a clip that doesn't loop
+			if (!m_Loop)
+			{
+				const double remaining = std::ceil((static_cast<double>(m_FrameCount) - m_Offset) / step);
+
+				count = std::min(count, static_cast<size_t>(std::max(remaining, 1.0)));
+			}
+
+			// the window starts a frame early so cubic interpolation can look behind
+			const auto first = static_cast<int64_t>(m_Offset);
+			const double fraction = m_Offset - static_cast<double>(first);
+			const auto needed = static_cast<size_t>(fraction + static_cast<double>(count - 1) * step) + c_WindowPadding;
+			const sf::Int16* samples = m_Buffer != nullptr ? FetchFrames(m_Buffer->GetBuffer().getSamples(), first - 1, needed) : DecodeFrames(first - 1, needed);
+
+			// the rest of the block is left silent, and the voice picks up from here once the stream catches up
+			if (samples == nullptr) break;
+
+			if (m_ChannelCount == 1)
+			{
+				kernels.ConvertToFloat(sourceLeft, samples, needed);
+			}
+			else if (m_ChannelCount == 2)
+			{
+				kernels.DeinterleaveToFloat(sourceLeft, sourceRight, samples, needed);
+			}
+			else
+			{
+				// anything past stereo only has its first two channels played
+				for (size_t i = 0; i < needed; i++)
+				{
+					sourceLeft[i] = static_cast<float>(samples[i * m_ChannelCount]) / 32768.0f;
+					sourceRight[i] = static_cast<float>(samples[i * m_ChannelCount + 1]) / 32768.0f;
+				}
+			}
+
+			const auto position = static_cast<float>(fraction + 1.0);
+			const float startLeft = m_GainLeft + rampLeft * static_cast<float>(done);
+			const float startRight = m_GainRight + rampRight * static_cast<float>(done);
+
+			resample(mixer.m_ResampledLeft.data(), sourceLeft, count, position, static_cast<float>(step));
+
+			if (m_ChannelCount == 1)
+			{
+				kernels.MixPanned(outputLeft + done, outputRight + done, mixer.m_ResampledLeft.data(), count, startLeft, startRight, rampLeft, rampRight);
+			}
+			else
+			{
+				resample(mixer.m_ResampledRight.data(), sourceRight, count, position, static_cast<float>(step));
+
+				kernels.MixGain(outputLeft + done, mixer.m_ResampledLeft.data(), count, startLeft, rampLeft);
+				kernels.MixGain(outputRight + done, mixer.m_ResampledRight.data(), count, startRight, rampRight);
+			}
+
+			m_Offset += static_cast<double>(count) * step;
+			done += count;
+
+			if (m_Offset < static_cast<double>(m_FrameCount)) continue;
+
+			if (!m_Loop)
+			{
+				m_Status = sf::SoundSource::Stopped;
+				m_Offset = 0;
+				break;
+			}
+
+			// wrap around, the window moves with it so what was already decoded stays in place
+			const auto wraps = static_cast<int64_t>(m_Offset / static_cast<double>(m_FrameCount));
+
+			m_Offset -= static_cast<double>(wraps) * static_cast<double>(m_FrameCount);
+			m_WindowStart -= wraps * static_cast<int64_t>(m_FrameCount);
+		}
+
+		m_GainLeft = gainLeft;
+		m_GainRight = gainRight;
+	}
+
+	void MixerVoice::Reset()
+	{
+		m_Status = sf::SoundSource::Stopped;
+		m_Clip.reset();
+		m_Buffer = nullptr;
+
+		if (m_Stream != nullptr && m_Mixer->m_StreamDecoder != nullptr) m_Mixer->m_StreamDecoder->Remove(m_Stream);
+
+		m_Stream.reset();
+		m_Offset = 0;
+		m_StartFrame = 0;
+		m_StopFrame = std::numeric_limits<uint64_t>::max();
+		m_Bus = 0;
+		m_WindowStart = 0;
+		m_WindowFrames = 0;
+	}
+
+	void MixerVoice::SetClip(const std::shared_ptr<const Clip>& clip, uint32_t channelCount, uint32_t sampleRate, uint64_t sampleCount)
+	{
+		Reset();
+
+		m_Clip = clip;
+		m_ChannelCount = channelCount;
+		m_SampleRate = sampleRate;
+		m_FrameCount = channelCount > 0 ? sampleCount / channelCount : 0;
+
+		// only allocates when a clip has more channels than any before it
+		m_Window.resize(std::max(m_Window.size(), c_WindowFrames * channelCount));
+	}
+
+	const sf::Int16* MixerVoice::FetchFrames(const sf::Int16* samples, int64_t first, size_t count)
+	{
+		const size_t channels = m_ChannelCount;
+
+		const auto frameCount = static_cast<int64_t>(m_FrameCount);
+
+		// read straight from the clip unless it runs off either end
+		if (first >= 0 && first + static_cast<int64_t>(count) <= frameCount) return samples + static_cast<size_t>(first) * channels;
+
+		for (size_t i = 0; i < count; i++)
+		{
+			int64_t frame = first + static_cast<int64_t>(i);
+			sf::Int16* target = m_Window.data() + i * channels;
+
+			if (m_Loop) frame = (frame % frameCount + frameCount) % frameCount;
+
+			if (frame >= 0 && frame < frameCount) std::copy_n(samples + static_cast<size_t>(frame) * channels, channels, target);
+			else std::fill_n(target, channels, sf::Int16(0));
+		}
+
+		return m_Window.data();
+	}
+
+	const sf::Int16* MixerVoice::DecodeFrames(int64_t first, size_t count)
+	{
+		const size_t channels = m_ChannelCount;
+
+		// start over if the offset jumped somewhere the window doesn't cover
+		if (first < m_WindowStart || first > m_WindowStart + static_cast<int64_t>(m_WindowFrames))
+		{
+			const auto frameCount = static_cast<int64_t>(m_FrameCount);
+			const auto lead = static_cast<size_t>(std::max<int64_t>(-first, 0));
+
+			// a window ending on the start of the clip is where the stream already is, as for a voice that just started
+			const bool isAtStream = lead > 0 && m_WindowStart + static_cast<int64_t>(m_WindowFrames) == 0;
+
+			// nothing comes before the start of the clip
+			std::fill_n(m_Window.begin(), lead * channels, sf::Int16(0));
+
+			m_WindowStart = first;
+			m_WindowFrames = lead;
+
+			// keeps what the workers decoded ahead instead of flushing it
+			if (!isAtStream) m_Stream->Seek(static_cast<uint64_t>((first + static_cast<int64_t>(lead)) % frameCount));
+		}
+
+		// drop everything that has already been played
+		const auto played = static_cast<size_t>(first - m_WindowStart);
+
+		std::copy(m_Window.begin() + played * channels, m_Window.begin() + m_WindowFrames * channels, m_Window.begin());
+		m_WindowStart = first;
+		m_WindowFrames -= played;
+
+		while (m_WindowFrames < count)
+		{
+			// without decode workers the stream is decoded right here, while mixing
+			if (m_Mixer->m_StreamDecoder == nullptr) m_Stream->Refill();
+
+			// fill the whole window so the stream is read as little as possible
+			sf::Int16* target = m_Window.data() + m_WindowFrames * channels;
+			const size_t read = m_Stream->Read(target, c_WindowFrames - m_WindowFrames);
+
+			m_WindowFrames += read;
+
+			if (read > 0) continue;
+
+			if (m_Stream->IsFinished())
+			{
+				// the frames past the end are silent, but aren't kept in case the voice is set to loop
+				std::fill(target, m_Window.data() + count * channels, sf::Int16(0));
+				break;
+			}
+
+			m_Stream->AddUnderrun();
+
+			return nullptr;
+		}
+
+		return m_Window.data();
+	}
+
+} // Mix
\ No newline at end of file
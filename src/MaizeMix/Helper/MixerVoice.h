@@ -0,0 +1,100 @@
+#pragma once
+
+#include <SFML/Audio.hpp>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <vector>
+
+namespace Mix {
+
+	class Mixer;
+	class Clip;
+	class SoundBuffer;
+	class StreamedClip;
+	class DecodeStream;
+
+	/**
+	 * Voice of the software mixer, mirrors the parts of sf::Sound the engine uses so it can be driven the same way
+	 * It only holds a weak reference to its clip, a removed clip stops it on the next mixed block
+	 */
+	class MixerVoice
+	{
+	 public:
+		MixerVoice() = default;
+
+		void setBuffer(const std::shared_ptr<const SoundBuffer>& buffer);
+		bool setSoundReference(const std::shared_ptr<const StreamedClip>& clip);
+		void resetBuffer();
+
+		void play();
+		void pause();
+		void stop();
+		sf::SoundSource::Status getStatus() const;
+
+		void setLoop(bool loop);
+		void setVolume(float volume);
+		void setPitch(float pitch);
+		void setPosition(const sf::Vector3f& position);
+
+		// index into Mixer::SetBuses, its gain and pause are applied on top of the voice's own
+		void setBus(uint32_t bus);
+
+		void setPlayingOffset(sf::Time timeOffset);
+		sf::Time getPlayingOffset() const;
+
+		// in mixed frames (Mixer::GetMixedFrames), a playing voice stays silent until the start and stops on the stop frame
+		// pausing or seeking drops the start frame
+		void setStartFrame(uint64_t frame);
+		void setStopFrame(uint64_t frame);
+
+		// seconds of a streamed clip decoded ahead of the mixer
+		float getBufferedTime() const;
+
+		// times a streamed clip was mixed before it was decoded
+		uint32_t getUnderruns() const;
+
+	 private:
+		friend class Mixer;
+
+		// only called by the mixer while it holds its lock, mixes into the block from outputOffset on
+		void Render(Mixer& mixer, size_t outputOffset, size_t frames, float busGain);
+
+		void Reset();
+		void SetClip(const std::shared_ptr<const Clip>& clip, uint32_t channelCount, uint32_t sampleRate, uint64_t sampleCount);
+		const sf::Int16* FetchFrames(const sf::Int16* samples, int64_t first, size_t count);
+		const sf::Int16* DecodeFrames(int64_t first, size_t count); // null if the stream hasn't decoded far enough
+
+	 private:
+		Mixer* m_Mixer = nullptr;
+
+		std::weak_ptr<const Clip> m_Clip;
+		const SoundBuffer* m_Buffer = nullptr; // decoded up front, read straight from the clip
+		std::shared_ptr<DecodeStream> m_Stream; // decoded while playing, by the mixer's decode workers if it has them
+
+		uint32_t m_ChannelCount = 0;
+		uint32_t m_SampleRate = 0;
+		uint64_t m_FrameCount = 0;
+
+		sf::SoundSource::Status m_Status = sf::SoundSource::Stopped;
+		bool m_Loop = false;
+		float m_Volume = 100.0f;
+		float m_Pitch = 1.0f;
+		uint32_t m_Bus = 0;
+		sf::Vector3f m_Position;
+
+		double m_Offset = 0; // in clip frames
+		uint64_t m_StartFrame = 0;
+		uint64_t m_StopFrame = std::numeric_limits<uint64_t>::max();
+		float m_GainLeft = 0; // gains reached by the last block, ramped towards the new ones to avoid clicks
+		float m_GainRight = 0;
+
+		std::vector<sf::Int16> m_Window; // contiguous frames the resampler reads from
+		int64_t m_WindowStart = 0;
+		size_t m_WindowFrames = 0;
+
+		static constexpr size_t c_WindowFrames = 4096;
+		static constexpr size_t c_WindowPadding = 4; // one frame before and two after what is played, for interpolation
+	};
+
+} // Mix
\ No newline at end of file
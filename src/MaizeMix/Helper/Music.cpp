@@ -1,5 +1,8 @@
 #include "MaizeMix/Helper/Music.h"
-#include "MaizeMix/Helper/AudioClips/SoundReference.h"
+#include "MaizeMix/Helper/AudioClips/StreamedClip.h"
+
+#include <algorithm>
+#include <cmath>
 
 namespace Mix {
 
@@ -13,7 +16,7 @@ namespace Mix {
 		}
 	}
 
-	bool Music::setSoundReference(const SoundReference& musicBuffer)
+	bool Music::setSoundReference(const StreamedClip& musicBuffer)
 	{
 		if (m_Reference != nullptr)
 		{
@@ -21,10 +24,12 @@ namespace Mix {
 			m_Reference->DetachReference(this);
 		}
 
-		if (openFromFile(musicBuffer.m_AudioPath))
+		if (openFromMemory(musicBuffer.GetData(), musicBuffer.GetSize()))
 		{
 			m_Reference = &musicBuffer;
 			m_Reference->AttachReference(this);
+			m_Head = musicBuffer.GetHead();
+			m_HeadOffset = 0;
 
 			return true;
 		}
@@ -32,7 +37,7 @@ namespace Mix {
 		return false;
 	}
 
-	const SoundReference* Music::getReference() const
+	const StreamedClip* Music::getReference() const
 	{
 		return m_Reference;
 	}
@@ -46,6 +51,59 @@ namespace Mix {
 			m_Reference->DetachReference(this);
 			m_Reference = nullptr;
 		}
+
+		m_Head.reset();
+	}
+
+	bool Music::onGetData(Chunk& data)
+	{
+		if (m_Head == nullptr || m_HeadOffset >= m_Head->size()) return sf::Music::onGetData(data);
+
+		// split so the whole first queue comes from the head and playback starts without decoding anything
+		const size_t frames = m_Head->size() / getChannelCount();
+		const size_t count = std::min((frames + c_HeadChunks - 1) / c_HeadChunks * getChannelCount(), m_Head->size() - m_HeadOffset);
+
+		data.samples = m_Head->data() + m_HeadOffset;
+		data.sampleCount = count;
+		m_HeadOffset += count;
+
+		// the file was left wherever the last seek put it, it carries on right after the head
+		if (m_HeadOffset >= m_Head->size())
+		{
+			const double seconds = static_cast<double>(frames) / getSampleRate();
+
+			// rounded up so the file doesn't land on the frame before
+			sf::Music::onSeek(sf::microseconds(static_cast<sf::Int64>(std::ceil(seconds * 1000000.0))));
+		}
+
+		return true;
+	}
+
+	void Music::onSeek(sf::Time timeOffset)
+	{
+		if (m_Head != nullptr)
+		{
+			const auto frame = static_cast<size_t>(static_cast<double>(timeOffset.asSeconds()) * getSampleRate());
+
+			m_HeadOffset = std::min(frame * getChannelCount(), m_Head->size());
+
+			// the head covers it, the file is sent past the head once it runs out
+			if (m_HeadOffset < m_Head->size()) return;
+		}
+
+		sf::Music::onSeek(timeOffset);
+	}
+
+	sf::Int64 Music::onLoop()
+	{
+		const sf::Int64 position = sf::Music::onLoop();
+
+		if (m_Head != nullptr && position >= 0)
+		{
+			m_HeadOffset = std::min(static_cast<size_t>(position), m_Head->size());
+		}
+
+		return position;
 	}
 
 } // Mix
\ No newline at end of file
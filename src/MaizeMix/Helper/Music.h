@@ -1,14 +1,17 @@
 #pragma once
 
 #include <SFML/Audio.hpp>
+#include <memory>
+#include <vector>
 
 namespace Mix {
 
-	class SoundReference;
+	class StreamedClip;
 
 	/**
 	 * Simple wrapper of sf::Music to allow it to act as sf::Sound
-	 * Still acts like sf::Music but stops if the audio clip (SoundReference) goes out of scope
+	 * Still acts like sf::Music but stops if the audio clip (StreamedClip) goes out of scope
+	 * Plays the clip head from memory while there is one, the file is only read past it
 	 */
 	class Music final : public sf::Music
 	{
@@ -16,12 +19,22 @@ namespace Mix {
 		Music() = default;
 		~Music() override;
 
-		bool setSoundReference(const SoundReference& musicBuffer);
-		const SoundReference* getReference() const;
+		bool setSoundReference(const StreamedClip& musicBuffer);
+		const StreamedClip* getReference() const;
 		void resetReference();
 
+	 protected:
+		bool onGetData(Chunk& data) override;
+		void onSeek(sf::Time timeOffset) override;
+		sf::Int64 onLoop() override;
+
 	 private:
-		const SoundReference* m_Reference = nullptr;
+		const StreamedClip* m_Reference = nullptr;
+
+		std::shared_ptr<const std::vector<sf::Int16>> m_Head;
+		size_t m_HeadOffset = 0; // samples of the head already handed out
+
+		static constexpr size_t c_HeadChunks = 3; // as many as sf::SoundStream queues up before it starts playing
 	};
 
 } // Mix
\ No newline at end of file
@@ -0,0 +1,153 @@
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include <limits>
+#include <utility>
+#include <vector>
+
+namespace Mix {
+
+	/**
+	 * Generation checked reference into a SlotMap, stays the same size as a uint64_t so it can be packed into one
+	 */
+	struct SlotHandle
+	{
+		static constexpr uint32_t c_InvalidIndex = std::numeric_limits<uint32_t>::max();
+
+		uint32_t index = c_InvalidIndex;
+		uint32_t generation = 0;
+
+		uint64_t ToKey() const
+		{
+			return static_cast<uint64_t>(generation) << 32 | index;
+		}
+
+		static SlotHandle FromKey(uint64_t key)
+		{
+			return { static_cast<uint32_t>(key), static_cast<uint32_t>(key >> 32) };
+		}
+
+		explicit operator bool() const
+		{
+			return index != c_InvalidIndex;
+		}
+
+		bool operator==(const SlotHandle& other) const = default;
+	};
+
+	/**
+	 * Keeps every value packed together in a single vector for iteration, while handles are resolved through a slot
+	 * table in a single indexed access. Erasing moves the last value into the hole, so value addresses are not stable
+	 */
+	template <typename T>
+	class SlotMap
+	{
+	 public:
+		template <typename... Args>
+		SlotHandle Emplace(Args&&... args)
+		{
+			uint32_t index;
+
+			// reuse a slot from a previous value if possible
+			if (m_FreeSlot != SlotHandle::c_InvalidIndex)
+			{
+				index = m_FreeSlot;
+				m_FreeSlot = m_Slots[index].dense;
+			}
+			else
+			{
+				index = static_cast<uint32_t>(m_Slots.size());
+				m_Slots.push_back({});
+			}
+
+			m_Slots[index].dense = static_cast<uint32_t>(m_Values.size());
+			m_Values.emplace_back(std::forward<Args>(args)...);
+			m_DenseToSlot.push_back(index);
+
+			return { index, m_Slots[index].generation };
+		}
+
+		void Erase(SlotHandle handle)
+		{
+			if (!Contains(handle)) return;
+
+			Slot& slot = m_Slots[handle.index];
+			const uint32_t last = static_cast<uint32_t>(m_Values.size() - 1);
+
+			// fill the hole with the last value to keep everything packed
+			if (slot.dense != last)
+			{
+				m_Values[slot.dense] = std::move(m_Values[last]);
+				m_DenseToSlot[slot.dense] = m_DenseToSlot[last];
+				m_Slots[m_DenseToSlot[last]].dense = slot.dense;
+			}
+
+			m_Values.pop_back();
+			m_DenseToSlot.pop_back();
+
+			// invalidate any handle still pointing at this slot
+			slot.generation++;
+			slot.dense = m_FreeSlot;
+			m_FreeSlot = handle.index;
+		}
+
+		T* Get(SlotHandle handle)
+		{
+			return Contains(handle) ? &m_Values[m_Slots[handle.index].dense] : nullptr;
+		}
+
+		const T* Get(SlotHandle handle) const
+		{
+			return Contains(handle) ? &m_Values[m_Slots[handle.index].dense] : nullptr;
+		}
+
+		bool Contains(SlotHandle handle) const
+		{
+			return handle.index < m_Slots.size() && m_Slots[handle.index].generation == handle.generation && IsOccupied(handle.index);
+		}
+
+		SlotHandle GetHandle(size_t denseIndex) const
+		{
+			const uint32_t index = m_DenseToSlot[denseIndex];
+
+			return { index, m_Slots[index].generation };
+		}
+
+		void Reserve(size_t capacity)
+		{
+			m_Values.reserve(capacity);
+			m_DenseToSlot.reserve(capacity);
+			m_Slots.reserve(capacity);
+		}
+
+		size_t Size() const { return m_Values.size(); }
+		bool Empty() const { return m_Values.empty(); }
+
+		auto begin() { return m_Values.begin(); }
+		auto end() { return m_Values.end(); }
+		auto begin() const { return m_Values.begin(); }
+		auto end() const { return m_Values.end(); }
+
+	 private:
+		bool IsOccupied(uint32_t index) const
+		{
+			const uint32_t dense = m_Slots[index].dense;
+
+			return dense < m_DenseToSlot.size() && m_DenseToSlot[dense] == index;
+		}
+
+	 private:
+		struct Slot
+		{
+			uint32_t dense = 0; // index into m_Values, or the next free slot when unused
+			uint32_t generation = 0;
+		};
+
+		std::vector<T> m_Values;
+		std::vector<uint32_t> m_DenseToSlot;
+		std::vector<Slot> m_Slots;
+		uint32_t m_FreeSlot = SlotHandle::c_InvalidIndex;
+	};
+
+} // Mix
\ No newline at end of file
@@ -0,0 +1,133 @@
+#include "MaizeMix/Helper/StreamDecoder.h"
+
+#include <algorithm>
+#include <limits>
+
+namespace Mix {
+
+	StreamDecoder::StreamDecoder(size_t threadCount)
+	{
+		m_Workers.reserve(threadCount);
+
+		for (size_t i = 0; i < threadCount; i++)
+		{
+			m_Workers.emplace_back(&StreamDecoder::WorkerLoop, this);
+		}
+	}
+
+	StreamDecoder::~StreamDecoder()
+	{
+		{
+			std::lock_guard lock(m_Mutex);
+			m_IsStopping = true;
+		}
+
+		m_Condition.notify_all();
+
+		for (auto& worker : m_Workers)
+		{
+			worker.join();
+		}
+	}
+
+	void StreamDecoder::Add(const std::shared_ptr<DecodeStream>& stream)
+	{
+		{
+			std::lock_guard lock(m_Mutex);
+			m_Streams.push_back({ stream });
+		}
+
+		m_Condition.notify_one();
+	}
+
+	void StreamDecoder::Remove(const std::shared_ptr<DecodeStream>& stream)
+	{
+		std::lock_guard lock(m_Mutex);
+
+		const auto it = std::find_if(m_Streams.begin(), m_Streams.end(), [&](const Entry& entry) { return entry.stream == stream; });
+
+		if (it == m_Streams.end()) return;
+
+		m_RemovedUnderruns += stream->GetUnderruns();
+
+		// a worker still refilling it holds its own reference
+		*it = std::move(m_Streams.back());
+		m_Streams.pop_back();
+	}
+
+	size_t StreamDecoder::GetStreamCount() const
+	{
+		std::lock_guard lock(m_Mutex);
+
+		return m_Streams.size();
+	}
+
+	uint64_t StreamDecoder::GetUnderruns() const
+	{
+		std::lock_guard lock(m_Mutex);
+
+		uint64_t underruns = m_RemovedUnderruns;
+
+		for (const auto& entry : m_Streams)
+		{
+			underruns += entry.stream->GetUnderruns();
+		}
+
+		return underruns;
+	}
+
+	std::shared_ptr<DecodeStream> StreamDecoder::ClaimMostUrgent()
+	{
+		Entry* urgent = nullptr;
+		float urgentTime = std::numeric_limits<float>::max();
+
+		for (auto& entry : m_Streams)
+		{
+			if (entry.isRefilling || !entry.stream->NeedsRefill()) continue;
+
+			const float buffered = entry.stream->GetBufferedTime();
+
+			if (buffered < urgentTime)
+			{
+				urgent = &entry;
+				urgentTime = buffered;
+			}
+		}
+
+		if (urgent == nullptr) return nullptr;
+
+		urgent->isRefilling = true;
+
+		return urgent->stream;
+	}
+
+	void StreamDecoder::WorkerLoop()
+	{
+		while (true)
+		{
+			std::shared_ptr<DecodeStream> stream;
+
+			{
+				std::unique_lock lock(m_Mutex);
+
+				// nothing tells the workers when the mixer reads, so they check back every so often
+				while (!m_IsStopping && (stream = ClaimMostUrgent()) == nullptr)
+				{
+					m_Condition.wait_for(lock, c_IdleInterval);
+				}
+
+				if (m_IsStopping) return;
+			}
+
+			stream->Refill();
+
+			std::lock_guard lock(m_Mutex);
+
+			// it may have been removed while it was refilled
+			const auto it = std::find_if(m_Streams.begin(), m_Streams.end(), [&](const Entry& entry) { return entry.stream == stream; });
+
+			if (it != m_Streams.end()) it->isRefilling = false;
+		}
+	}
+
+} // Mix
\ No newline at end of file
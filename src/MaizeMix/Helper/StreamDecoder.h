@@ -0,0 +1,59 @@
+#pragma once
+
+#include <condition_variable>
+#include <cstdint>
+#include <atomic>
+#include <memory>
+#include <thread>
+#include <vector>
+#include <mutex>
+
+#include "MaizeMix/Helper/DecodeStream.h"
+
+namespace Mix {
+
+	/**
+	 * Fixed set of decode workers shared by every streamed mixer voice, instead of a thread per stream
+	 * Each worker refills whichever stream has the least audio buffered, so the closest to running dry goes first
+	 */
+	class StreamDecoder
+	{
+	 public:
+		explicit StreamDecoder(size_t threadCount);
+		~StreamDecoder();
+
+		StreamDecoder(const StreamDecoder&) = delete;
+		StreamDecoder& operator=(const StreamDecoder&) = delete;
+
+		void Add(const std::shared_ptr<DecodeStream>& stream);
+		void Remove(const std::shared_ptr<DecodeStream>& stream);
+
+		size_t GetStreamCount() const;
+
+		// underruns of every stream since the decoder was created, including removed ones
+		uint64_t GetUnderruns() const;
+
+	 private:
+		void WorkerLoop();
+
+		std::shared_ptr<DecodeStream> ClaimMostUrgent();
+
+	 private:
+		struct Entry
+		{
+			std::shared_ptr<DecodeStream> stream;
+			bool isRefilling = false; // claimed by a worker
+		};
+
+		std::vector<std::thread> m_Workers;
+		std::vector<Entry> m_Streams;
+		uint64_t m_RemovedUnderruns = 0;
+
+		mutable std::mutex m_Mutex;
+		std::condition_variable m_Condition;
+		bool m_IsStopping = false;
+
+		static constexpr auto c_IdleInterval = std::chrono::milliseconds(2);
+	};
+
+} // Mix
\ No newline at end of file
@@ -0,0 +1,60 @@
+#include "MaizeMix/Helper/ThreadPool.h"
+
+namespace Mix {
+
+	ThreadPool::ThreadPool(size_t threadCount)
+	{
+		m_Workers.reserve(threadCount);
+
+		for (size_t i = 0; i < threadCount; i++)
+		{
+			m_Workers.emplace_back(&ThreadPool::WorkerLoop, this);
+		}
+	}
+
+	ThreadPool::~ThreadPool()
+	{
+		{
+			std::lock_guard lock(m_Mutex);
+			m_IsStopping = true;
+		}
+
+		m_Condition.notify_all();
+
+		for (auto& worker : m_Workers)
+		{
+			worker.join();
+		}
+	}
+
+	void ThreadPool::Enqueue(std::function<void()>&& job)
+	{
+		{
+			std::lock_guard lock(m_Mutex);
+			m_Jobs.push_back(std::move(job));
+		}
+
+		m_Condition.notify_one();
+	}
+
+	void ThreadPool::WorkerLoop()
+	{
+		while (true)
+		{
+			std::function<void()> job;
+
+			{
+				std::unique_lock lock(m_Mutex);
+				m_Condition.wait(lock, [this]() { return m_IsStopping || !m_Jobs.empty(); });
+
+				if (m_IsStopping) return;
+
+				job = std::move(m_Jobs.front());
+				m_Jobs.pop_front();
+			}
+
+			job();
+		}
+	}
+
+} // Mix
\ No newline at end of file
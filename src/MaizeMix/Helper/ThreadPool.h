@@ -0,0 +1,39 @@
+#pragma once
+
+#include <condition_variable>
+#include <functional>
+#include <thread>
+#include <vector>
+#include <mutex>
+#include <deque>
+
+namespace Mix {
+
+	/**
+	 * Fixed set of worker threads pulling jobs off a shared queue
+	 * Jobs still queued when the pool is destroyed are dropped, the ones already running are waited on
+	 */
+	class ThreadPool
+	{
+	 public:
+		explicit ThreadPool(size_t threadCount);
+		~ThreadPool();
+
+		ThreadPool(const ThreadPool&) = delete;
+		ThreadPool& operator=(const ThreadPool&) = delete;
+
+		void Enqueue(std::function<void()>&& job);
+
+	 private:
+		void WorkerLoop();
+
+	 private:
+		std::vector<std::thread> m_Workers;
+		std::deque<std::function<void()>> m_Jobs;
+
+		std::mutex m_Mutex;
+		std::condition_variable m_Condition;
+		bool m_IsStopping = false;
+	};
+
+} // Mix
\ No newline at end of file
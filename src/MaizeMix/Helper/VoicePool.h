@@ -0,0 +1,71 @@
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+namespace Mix {
+
+	/**
+	 * Fixed size pool of backend voices (sf::Sound / Music / MixerVoice)
+	 * Every voice is constructed up front so acquiring and releasing one never allocates or creates a backend source
+	 */
+	template <typename T>
+	class VoicePool
+	{
+	 public:
+		explicit VoicePool(size_t capacity) : m_Voices(std::make_unique<T[]>(capacity)), m_Capacity(capacity)
+		{
+			m_FreeVoices.reserve(capacity);
+
+			// hand out voices in order of construction
+			for (size_t i = capacity; i > 0; --i)
+			{
+				m_FreeVoices.push_back(&m_Voices[i - 1]);
+			}
+		}
+
+		T* Acquire()
+		{
+			if (m_FreeVoices.empty()) return nullptr;
+
+			T* voice = m_FreeVoices.back();
+			m_FreeVoices.pop_back();
+
+			return voice;
+		}
+
+		void Release(T* voice)
+		{
+			m_FreeVoices.push_back(voice);
+		}
+
+		bool IsExhausted() const
+		{
+			return m_FreeVoices.empty();
+		}
+
+		size_t Capacity() const
+		{
+			return m_Capacity;
+		}
+
+		size_t InUse() const
+		{
+			return m_Capacity - m_FreeVoices.size();
+		}
+
+		// every voice, whether it is handed out or not
+		T* begin() { return m_Voices.get(); }
+		T* end() { return m_Voices.get() + m_Capacity; }
+
+		const T* begin() const { return m_Voices.get(); }
+		const T* end() const { return m_Voices.get() + m_Capacity; }
+
+	 private:
+		std::unique_ptr<T[]> m_Voices;
+		std::vector<T*> m_FreeVoices;
+		size_t m_Capacity = 0;
+	};
+
+} // Mix
\ No newline at end of file
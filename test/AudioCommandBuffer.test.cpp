@@ -0,0 +1,163 @@
+#include <catch2/catch_test_macros.hpp>
+#include <MaizeMix.h>
+
+#include <thread>
+#include <vector>
+
+TEST_CASE("Submitting commands", "[AudioCommandBuffer]")
+{
+	Mix::AudioEngine engine;
+	Mix::AudioCommandBuffer commands;
+	const auto clip = engine.CreateClip("Clips/Pew.wav", false);
+	const auto spec = Mix::AudioSpecification(false, true, 100, 1);
+
+	commands.PlayAudio(1, clip, spec);
+	commands.PlayAudio(2, clip, spec);
+	commands.PlayAudio(3, clip, spec);
+	commands.PauseAudio(2);
+	commands.StopAudio(3);
+
+	REQUIRE(commands.Size() == 5);
+
+	engine.Submit(commands);
+
+	// submitting leaves the buffer ready to be recorded into again
+	REQUIRE(commands.Empty());
+	REQUIRE(engine.EmitterCount() == 1);
+	REQUIRE(engine.UnpauseAudio(2) == true);
+	REQUIRE_FALSE(engine.GetAudioHandle(3));
+}
+
+TEST_CASE("Scheduling commands", "[AudioCommandBuffer]")
+{
+	Mix::AudioEngine engine;
+	Mix::AudioCommandBuffer commands;
+	const auto clip = engine.CreateClip("Clips/Pew.wav", false);
+	const auto spec = Mix::AudioSpecification(true, true, 100, 1);
+	const uint64_t second = engine.GetTickRate();
+
+	// a whole bar prescheduled in one go
+	for (uint64_t beat = 0; beat < 4; beat++)
+	{
+		commands.PlayAudioAt(beat, clip, spec, second * (beat + 1));
+		commands.StopAudioAt(beat, second * (beat + 1) + second / 2);
+	}
+
+	engine.Submit(commands);
+
+	REQUIRE(engine.EmitterCount() == 0);
+
+	engine.Update(1.0f);
+
+	REQUIRE(engine.EmitterCount() == 1);
+
+	engine.Update(2.0f);
+
+	REQUIRE(engine.EmitterCount() == 1);
+
+	engine.Update(2.0f);
+
+	REQUIRE(engine.EmitterCount() == 0);
+}
+
+TEST_CASE("Coalescing commands", "[AudioCommandBuffer]")
+{
+	Mix::AudioEngine engine;
+	Mix::AudioCommandBuffer commands;
+	const auto clip = engine.CreateClip("Clips/Pew.wav", false);
+	uint32_t finished = 0;
+
+	engine.SetAudioFinishCallback([&](uint64_t)
+	{
+		finished++;
+	});
+
+	// restarting the same entity only plays the last one
+	commands.PlayAudio(1, clip, Mix::AudioSpecification(false, false, 100, 1));
+	commands.SetAudioPitch(1, 4);
+	commands.PlayAudio(1, clip, Mix::AudioSpecification(false, false, 100, 1));
+	commands.SetAudioLoopState(1, true);
+	commands.SetAudioLoopState(1, false);
+	commands.SetAudioLoopState(1, true);
+
+	engine.Submit(commands);
+
+	REQUIRE(finished == 0);
+	REQUIRE(engine.EmitterCount() == 1);
+
+	// the last loop state won, so the voice never finishes
+	engine.Update(clip.GetDuration() * 2);
+
+	REQUIRE(engine.EmitterCount() == 1);
+}
+
+TEST_CASE("Appending commands", "[AudioCommandBuffer]")
+{
+	Mix::AudioEngine engine;
+	Mix::AudioCommandBuffer first;
+	Mix::AudioCommandBuffer second;
+	const auto clip = engine.CreateClip("Clips/Pew.wav", false);
+	const auto spec = Mix::AudioSpecification(false, true, 100, 1);
+
+	first.PlayAudio(1, clip, spec);
+	second.StopAudio(1);
+	second.PlayAudio(2, clip, spec);
+
+	// commands from the appended buffer happen after the existing ones
+	first.Append(second);
+	engine.Submit(first);
+
+	REQUIRE_FALSE(engine.GetAudioHandle(1));
+	REQUIRE(engine.GetAudioHandle(2));
+}
+
+TEST_CASE("Enqueueing commands from threads", "[AudioCommandBuffer]")
+{
+	Mix::AudioEngine engine(0, 0);
+	const auto clip = engine.CreateClip("Clips/Pew.wav", false);
+	const auto spec = Mix::AudioSpecification(false, true, 100, 1);
+	std::vector<std::thread> threads;
+
+	for (uint64_t thread = 0; thread < 4; thread++)
+	{
+		threads.emplace_back([&, thread]()
+		{
+			Mix::AudioCommandBuffer commands;
+
+			for (uint64_t i = 0; i < 16; i++)
+			{
+				commands.PlayAudio(thread * 16 + i, clip, spec);
+
+				while (!engine.Enqueue(commands)) std::this_thread::yield();
+			}
+		});
+	}
+
+	for (auto& thread : threads) thread.join();
+
+	// nothing is applied until the engine updates
+	REQUIRE(engine.EmitterCount() == 0);
+
+	engine.Update(0.0f);
+
+	REQUIRE(engine.EmitterCount() == 64);
+}
+
+TEST_CASE("Audio thread", "[AudioEngine]")
+{
+	Mix::AudioEngine engine;
+
+	engine.StartAudioThread();
+
+	REQUIRE(engine.IsAudioThreadRunning());
+
+	// engine wide state belongs to the audio thread while it runs
+	REQUIRE_FALSE(engine.SetVoiceLimit(8));
+	REQUIRE_FALSE(engine.SetBusVolume(Mix::AudioEngine::c_MasterBus, 50));
+	REQUIRE(engine.CreateBus() == Mix::AudioEngine::c_InvalidBus);
+
+	engine.StopAudioThread();
+
+	REQUIRE_FALSE(engine.IsAudioThreadRunning());
+	REQUIRE(engine.SetVoiceLimit(8));
+}
\ No newline at end of file
@@ -1,6 +1,10 @@
 #include <catch2/catch_test_macros.hpp>
 #include <MaizeMix.h>
 
+#include "MaizeMix/Helper/Mixer.h"
+
+#include <thread>
+
 TEST_CASE("Playing sound", "[AudioEngine]")
 {
 	Mix::AudioEngine engine;
@@ -8,7 +12,7 @@ TEST_CASE("Playing sound", "[AudioEngine]")
 	const auto spec = Mix::AudioSpecification(false, true, 100, 1);
 	constexpr uint64_t entity = 12345;
 
-	REQUIRE(engine.PlayAudio(entity, clip, spec) == true);
+	REQUIRE(engine.PlayAudio(entity, clip, spec));
 	REQUIRE(engine.EmitterCount() == 1);
 }
 
@@ -19,10 +23,23 @@ TEST_CASE("Playing stream", "[AudioEngine]")
 	const auto spec = Mix::AudioSpecification(false, true, 100, 1);
 	constexpr uint64_t entity = 12345;
 
-	REQUIRE(engine.PlayAudio(entity, clip, spec) == true);
+	REQUIRE(engine.PlayAudio(entity, clip, spec));
 	REQUIRE(engine.EmitterCount() == 1);
 }
 
+TEST_CASE("Playing compressed", "[AudioEngine]")
+{
+	Mix::AudioEngine engine;
+	const auto clip = engine.CreateClip("Clips/Pew.wav", Mix::AudioClip::LoadType::CompressedInMemory);
+	const auto spec = Mix::AudioSpecification(false, true, 100, 1);
+	constexpr uint64_t entity = 12345;
+
+	REQUIRE(engine.PlayAudio(entity, clip, spec));
+	REQUIRE(engine.EmitterCount() == 1);
+	REQUIRE(engine.HasExhaustedStreamVoices() == false);
+	REQUIRE(engine.RealEmitterCount() == 1);
+}
+
 TEST_CASE("Attempt playing sound", "[AudioEngine]")
 {
 	Mix::AudioEngine engine;
@@ -32,7 +49,7 @@ TEST_CASE("Attempt playing sound", "[AudioEngine]")
 
 	engine.RemoveClip(clip);
 
-	REQUIRE(engine.PlayAudio(entity, clip, spec) == false);
+	REQUIRE_FALSE(engine.PlayAudio(entity, clip, spec));
 	REQUIRE(engine.EmitterCount() == 0);
 }
 
@@ -45,7 +62,7 @@ TEST_CASE("Attempt playing stream", "[AudioEngine]")
 
 	engine.RemoveClip(clip);
 
-	REQUIRE(engine.PlayAudio(entity, clip, spec) == false);
+	REQUIRE_FALSE(engine.PlayAudio(entity, clip, spec));
 	REQUIRE(engine.EmitterCount() == 0);
 }
 
@@ -101,21 +118,230 @@ TEST_CASE("Stop invalid handling", "[Sound]")
 
 TEST_CASE("Playing max emitters", "[AudioEngine]")
 {
-	Mix::AudioEngine engine;
+	Mix::AudioEngine engine(255, 0);
 	auto clip = engine.CreateClip("Clips/Pew.wav", false);
 	auto spec = Mix::AudioSpecification(false, true, 100, 1);
 
-	for (uint8_t i = 0; i < 255; ++i)
+	for (uint32_t i = 0; i < 1000; ++i)
 	{
-		REQUIRE(engine.PlayAudio(i, clip, spec) == true);
+		REQUIRE(engine.PlayAudio(i, clip, spec));
 	}
 
-	REQUIRE(engine.EmitterCount() == 255);
-	REQUIRE(engine.PlayAudio(255, clip, spec) == false);
-	REQUIRE(engine.EmitterCount() == 255);
+	// past the backend budget voices are still accepted, only virtually
+	REQUIRE(engine.EmitterCount() == 1000);
+	REQUIRE(engine.RealEmitterCount() == 255);
+	REQUIRE(engine.VirtualEmitterCount() == 745);
 	REQUIRE(engine.HasHitMaxAudioSources() == true);
 }
 
+TEST_CASE("Exhausting voice pool", "[AudioEngine]")
+{
+	Mix::AudioEngine engine(2, 1);
+	const auto sound = engine.CreateClip("Clips/Pew.wav", false);
+	const auto stream = engine.CreateClip("Clips/Pew.wav", true);
+	const auto spec = Mix::AudioSpecification(false, true, 100, 1);
+
+	REQUIRE(engine.PlayAudio(0, sound, spec));
+	REQUIRE(engine.PlayAudio(1, sound, spec));
+	REQUIRE(engine.PlayAudio(2, sound, spec));
+	REQUIRE(engine.HasExhaustedSoundVoices() == true);
+	REQUIRE(engine.HasHitMaxAudioSources() == false);
+	REQUIRE(engine.IsAudioVirtual(2) == true);
+
+	// streams have their own voices
+	REQUIRE(engine.PlayAudio(3, stream, spec));
+	REQUIRE(engine.HasExhaustedStreamVoices() == true);
+
+	// stopped voices go back to the pool and the virtual voice takes it over
+	engine.StopAudio(0);
+	engine.Update(0.0f);
+
+	REQUIRE(engine.IsAudioVirtual(2) == false);
+	REQUIRE(engine.RealEmitterCount() == 3);
+	REQUIRE(engine.VirtualEmitterCount() == 0);
+}
+
+TEST_CASE("Virtual voice priority", "[AudioEngine]")
+{
+	Mix::AudioEngine engine(1, 0);
+	const auto clip = engine.CreateClip("Clips/Pew.wav", false);
+
+	REQUIRE(engine.PlayAudio(0, clip, Mix::AudioSpecification(false, false, 100, 1, 0)));
+	REQUIRE(engine.PlayAudio(1, clip, Mix::AudioSpecification(false, false, 100, 1, 10)));
+	REQUIRE(engine.IsAudioVirtual(1) == true);
+
+	engine.Update(0.1f);
+
+	// the more important voice takes over the backend voice
+	REQUIRE(engine.IsAudioVirtual(0) == true);
+	REQUIRE(engine.IsAudioVirtual(1) == false);
+	REQUIRE(engine.EmitterCount() == 2);
+}
+
+TEST_CASE("Virtual voice hysteresis", "[AudioEngine]")
+{
+	Mix::AudioEngine engine(2, 0);
+	const auto clip = engine.CreateClip("Clips/Pew.wav", false);
+	const auto spec = Mix::AudioSpecification(false, true, 50, 1);
+
+	for (uint64_t entity = 0; entity < 4; entity++)
+	{
+		REQUIRE(engine.PlayAudio(entity, clip, spec));
+	}
+
+	// equally important voices keep whatever they already have
+	for (int i = 0; i < 10; i++)
+	{
+		engine.Update(0.01f);
+
+		REQUIRE(engine.IsAudioVirtual(0) == false);
+		REQUIRE(engine.IsAudioVirtual(1) == false);
+		REQUIRE(engine.IsAudioVirtual(2) == true);
+		REQUIRE(engine.IsAudioVirtual(3) == true);
+	}
+
+	// barely louder isn't enough to take over a voice
+	REQUIRE(engine.SetAudioVolume(2, 55));
+	engine.Update(0.01f);
+
+	REQUIRE(engine.IsAudioVirtual(2) == true);
+
+	REQUIRE(engine.SetAudioVolume(2, 100));
+	engine.Update(0.01f);
+
+	REQUIRE(engine.IsAudioVirtual(2) == false);
+	REQUIRE(engine.RealEmitterCount() == 2);
+}
+
+TEST_CASE("Virtual voice finishing", "[AudioEngine]")
+{
+	Mix::AudioEngine engine(0, 0);
+	const auto clip = engine.CreateClip("Clips/Pew.wav", false);
+	const auto spec = Mix::AudioSpecification(false, true, 100, 1);
+	constexpr uint64_t entity = 12345;
+
+	REQUIRE(engine.PlayAudio(entity, clip, spec));
+	REQUIRE(engine.VirtualEmitterCount() == 1);
+
+	// virtual voices still keep track of where they are
+	engine.Update(0.2f);
+
+	REQUIRE(engine.GetAudioOffsetTime(entity) >= 0.19f);
+	REQUIRE(engine.GetAudioOffsetTime(entity) <= 0.21f);
+
+	engine.Update(clip.GetDuration());
+
+	REQUIRE(engine.EmitterCount() == 0);
+	REQUIRE(engine.VirtualEmitterCount() == 0);
+}
+
+TEST_CASE("Audio handles", "[AudioEngine]")
+{
+	Mix::AudioEngine engine;
+	const auto clip = engine.CreateClip("Clips/Pew.wav", false);
+	const auto spec = Mix::AudioSpecification(false, true, 100, 1);
+	constexpr uint64_t entity = 12345;
+
+	const auto handle = engine.PlayAudio(entity, clip, spec);
+
+	REQUIRE(handle);
+	REQUIRE(engine.GetAudioHandle(entity) == handle);
+	REQUIRE(engine.SetAudioPitch(handle, 2) == true);
+	REQUIRE(engine.StopAudio(handle) == true);
+
+	// a stopped voice can't be reached through its old handle
+	REQUIRE(engine.SetAudioPitch(handle, 1) == false);
+	REQUIRE_FALSE(engine.GetAudioHandle(entity));
+
+	// replaying the entity hands out a new handle for the same slot
+	const auto replayed = engine.PlayAudio(entity, clip, spec);
+
+	REQUIRE(replayed.index == handle.index);
+	REQUIRE_FALSE(replayed == handle);
+	REQUIRE(engine.StopAudio(handle) == false);
+	REQUIRE(engine.EmitterCount() == 1);
+}
+
+TEST_CASE("Playing pending clip", "[AudioEngine]")
+{
+	Mix::AudioEngine engine;
+	const auto clip = engine.CreateClipAsync("Clips/Pew.wav", false);
+	const auto spec = Mix::AudioSpecification(false, true, 100, 1);
+
+	// queued until the clip is loaded, unless the worker already finished it
+	REQUIRE(engine.PlayAudio(0, clip, spec));
+
+	while (clip.GetLoadState() == Mix::AudioClip::LoadState::Unloaded)
+	{
+		std::this_thread::yield();
+	}
+
+	engine.Update(0);
+
+	REQUIRE(engine.EmitterCount() == 1);
+	REQUIRE(engine.RealEmitterCount() == 1);
+}
+
+TEST_CASE("Pausing pending clip", "[AudioEngine]")
+{
+	Mix::AudioEngine engine;
+	const auto clip = engine.CreateClipAsync("Clips/Pew.wav", false);
+	const auto spec = Mix::AudioSpecification(false, true, 100, 1);
+
+	REQUIRE(engine.PlayAudio(0, clip, spec));
+	REQUIRE(engine.PauseAudio(0));
+
+	while (clip.GetLoadState() == Mix::AudioClip::LoadState::Unloaded)
+	{
+		std::this_thread::yield();
+	}
+
+	// loading the clip doesn't start it
+	engine.Update(0.1f);
+
+	REQUIRE(engine.EmitterCount() == 0);
+	REQUIRE(engine.GetAudioOffsetTime(0) < 0.05f);
+
+	REQUIRE(engine.UnpauseAudio(0));
+	engine.Update(0);
+
+	REQUIRE(engine.EmitterCount() == 1);
+	REQUIRE(engine.RealEmitterCount() == 1);
+}
+
+TEST_CASE("Rejecting pending clip", "[AudioEngine]")
+{
+	Mix::AudioEngine engine;
+	const auto spec = Mix::AudioSpecification(false, true, 100, 1);
+	uint64_t finished = 0;
+
+	engine.SetPendingClipPolicy(Mix::AudioEngine::PendingClipPolicy::Reject);
+	engine.SetAudioFinishCallback([&](uint64_t) { finished++; });
+
+	const auto clip = engine.CreateClipAsync("error test", false);
+
+	if (clip.GetLoadState() == Mix::AudioClip::LoadState::Unloaded)
+	{
+		REQUIRE_FALSE(engine.PlayAudio(0, clip, spec));
+	}
+
+	// a queued play on a clip that fails to load is finished straight away
+	engine.SetPendingClipPolicy(Mix::AudioEngine::PendingClipPolicy::Queue);
+	const bool queued = static_cast<bool>(engine.PlayAudio(1, clip, spec));
+
+	while (clip.GetLoadState() == Mix::AudioClip::LoadState::Unloaded)
+	{
+		std::this_thread::yield();
+	}
+
+	engine.Update(0);
+
+	REQUIRE(clip.GetLoadState() == Mix::AudioClip::LoadState::Failed);
+	REQUIRE_FALSE(engine.PlayAudio(2, clip, spec));
+	REQUIRE(finished == (queued ? 1 : 0));
+	REQUIRE(engine.VirtualEmitterCount() == 0);
+}
+
 TEST_CASE("Auto sound removal", "[AudioEngine]")
 {
 	Mix::AudioEngine engine;
@@ -160,6 +386,34 @@ TEST_CASE("Auto stream removal", "[AudioEngine]")
 	REQUIRE(engine.EmitterCount() == 0);
 }
 
+TEST_CASE("Sounds finish in stop time order", "[AudioEngine]")
+{
+	Mix::AudioEngine engine;
+	const auto clip = engine.CreateClip("Clips/Pew.wav", false);
+	const auto spec = Mix::AudioSpecification(false, true, 100, 1);
+	std::vector<uint64_t> finished;
+
+	engine.SetAudioFinishCallback([&](uint64_t entityID)
+	{
+		finished.push_back(entityID);
+	});
+
+	// the higher entity starts first so it must also finish first
+	engine.PlayAudio(2, clip, spec);
+	engine.Update(0.1f);
+	engine.PlayAudio(1, clip, spec);
+
+	engine.Update(clip.GetDuration() - 0.05f);
+
+	REQUIRE(finished == std::vector<uint64_t>{ 2 });
+	REQUIRE(engine.EmitterCount() == 1);
+
+	engine.Update(0.1f);
+
+	REQUIRE(finished == std::vector<uint64_t>{ 2, 1 });
+	REQUIRE(engine.EmitterCount() == 0);
+}
+
 TEST_CASE("Pausing sound", "[AudioEngine]")
 {
 	Mix::AudioEngine engine;
@@ -217,7 +471,7 @@ TEST_CASE("Play, pause, unpause, and stop", "[AudioEngine]")
 	});
 
 	// play the audio clip
-	REQUIRE(engine.PlayAudio(entity, clip, Mix::AudioSpecification(false, true, 100, 1)) == true);
+	REQUIRE(engine.PlayAudio(entity, clip, Mix::AudioSpecification(false, true, 100, 1)));
 	REQUIRE(engine.EmitterCount() == 1);
 
 	// pause the audio clip
@@ -239,11 +493,11 @@ TEST_CASE("Repeated PlayClip calls", "[AudioEngine]")
 	const auto clip = engine.CreateClip("Clips/Pew.wav", false);
 	constexpr uint64_t entity = 12345;
 
-	REQUIRE(engine.PlayAudio(entity, clip, Mix::AudioSpecification(false, true, 100, 1)) == true);
+	REQUIRE(engine.PlayAudio(entity, clip, Mix::AudioSpecification(false, true, 100, 1)));
 	REQUIRE(engine.EmitterCount() == 1);
 
 	// should not alter state
-	REQUIRE(engine.PlayAudio(entity, clip, Mix::AudioSpecification(false, true, 100, 1)) == true);
+	REQUIRE(engine.PlayAudio(entity, clip, Mix::AudioSpecification(false, true, 100, 1)));
 	REQUIRE(engine.EmitterCount() == 1);
 }
 
@@ -299,4 +553,673 @@ TEST_CASE("Listener", "[AudioEngine]")
 
 	REQUIRE(engine.SetListenerPosition(0, 0, 0) == false);
 	REQUIRE(engine.SetGlobalVolume(0) == false);
-}
\ No newline at end of file
+}
+
+TEST_CASE("Engine stats", "[AudioEngine]")
+{
+	Mix::AudioEngine engine(1, 1);
+	const auto sound = engine.CreateClip("Clips/Pew.wav", false);
+	const auto stream = engine.CreateClip("Clips/Pew.wav", true);
+	const auto spec = Mix::AudioSpecification(false, false, 100, 1);
+
+	REQUIRE(engine.PlayAudio(0, sound, spec));
+	REQUIRE(engine.PlayAudio(1, stream, spec));
+	REQUIRE(engine.PlayAudio(2, sound, spec));
+	REQUIRE_FALSE(engine.PlayAudio(3, Mix::AudioClip(), spec));
+
+	engine.Update(0.0f);
+
+	auto stats = engine.GetStats();
+
+	REQUIRE(stats.voicesStarted == 3);
+	REQUIRE(stats.GetRejectedPlays(Mix::PlayRejection::ExpiredClip) == 1);
+	REQUIRE(stats.GetRejectedPlays() == 1);
+	REQUIRE(stats.soundVoices == 1);
+	REQUIRE(stats.streamVoices == 1);
+	REQUIRE(stats.virtualVoices == 1);
+	REQUIRE(stats.clipCount == 2);
+	REQUIRE(stats.clipMemory == sound.GetMemoryUsage() + stream.GetMemoryUsage());
+	REQUIRE(stats.clipLoadTime > 0.0f);
+
+	// counters only cover the frame since the last update
+	REQUIRE(engine.StopAudio(0));
+
+	engine.Update(0.0f);
+	stats = engine.GetStats();
+
+	REQUIRE(stats.voicesStarted == 0);
+	REQUIRE(stats.voicesStopped == 1);
+	REQUIRE(stats.GetRejectedPlays() == 0);
+
+	engine.Update(1.0f);
+	stats = engine.GetStats();
+
+	REQUIRE(stats.voicesFinished == 2);
+	REQUIRE(stats.soundVoices + stats.streamVoices + stats.virtualVoices == 0);
+}
+
+TEST_CASE("Voice limit stealing", "[AudioEngine]")
+{
+	using StealPolicy = Mix::AudioEngine::StealPolicy;
+	using FinishReason = Mix::AudioEngine::FinishReason;
+
+	Mix::AudioEngine engine(8, 2);
+	const auto clip = engine.CreateClip("Clips/Pew.wav", false);
+	std::vector<std::pair<uint64_t, FinishReason>> finished;
+
+	engine.SetAudioFinishCallback([&](uint64_t entityID, FinishReason reason) { finished.emplace_back(entityID, reason); });
+
+	SECTION("Lowest priority")
+	{
+		engine.SetVoiceLimit(2, StealPolicy::LowestPriority);
+
+		REQUIRE(engine.PlayAudio(0, clip, Mix::AudioSpecification(false, false, 100, 1, 1)));
+		REQUIRE(engine.PlayAudio(1, clip, Mix::AudioSpecification(false, false, 100, 1, 5)));
+		REQUIRE(engine.PlayAudio(2, clip, Mix::AudioSpecification(false, false, 100, 1, 3)));
+		REQUIRE_FALSE(engine.GetAudioHandle(0));
+
+		// the callback waits for the update
+		REQUIRE(finished.empty());
+
+		engine.Update(0.0f);
+
+		REQUIRE(finished.size() == 1);
+		REQUIRE(finished[0] == std::make_pair(uint64_t(0), FinishReason::Stolen));
+		REQUIRE(engine.GetStats().voicesStolen == 1);
+
+		// everything playing outranks it
+		REQUIRE_FALSE(engine.PlayAudio(3, clip, Mix::AudioSpecification(false, false, 100, 1, 0)));
+
+		// the stolen voice fades out without finishing again
+		engine.Update(0.1f);
+
+		REQUIRE(engine.EmitterCount() == 2);
+		REQUIRE(finished.size() == 1);
+		REQUIRE(engine.GetStats().GetRejectedPlays(Mix::PlayRejection::VoiceLimit) == 1);
+	}
+
+	SECTION("Oldest")
+	{
+		engine.SetVoiceLimit(2, StealPolicy::Oldest);
+
+		REQUIRE(engine.PlayAudio(0, clip, Mix::AudioSpecification(false, false, 100, 1)));
+		engine.Update(0.1f);
+		REQUIRE(engine.PlayAudio(1, clip, Mix::AudioSpecification(false, false, 100, 1)));
+		REQUIRE(engine.PlayAudio(2, clip, Mix::AudioSpecification(false, false, 100, 1)));
+
+		engine.Update(0.0f);
+
+		REQUIRE(finished == std::vector{ std::make_pair(uint64_t(0), FinishReason::Stolen) });
+	}
+
+	SECTION("Quietest")
+	{
+		engine.SetVoiceLimit(2, StealPolicy::Quietest);
+
+		REQUIRE(engine.PlayAudio(0, clip, Mix::AudioSpecification(false, false, 100, 1)));
+		REQUIRE(engine.PlayAudio(1, clip, Mix::AudioSpecification(false, false, 100, 1)));
+		REQUIRE(engine.SetAudioVolume(1, 10));
+		REQUIRE(engine.PlayAudio(2, clip, Mix::AudioSpecification(false, false, 50, 1)));
+
+		engine.Update(0.0f);
+
+		REQUIRE(finished == std::vector{ std::make_pair(uint64_t(1), FinishReason::Stolen) });
+	}
+
+	SECTION("Furthest")
+	{
+		engine.SetVoiceLimit(2, StealPolicy::Furthest);
+
+		REQUIRE(engine.PlayAudio(0, clip, Mix::AudioSpecification(false, false, 100, 1)));
+		REQUIRE(engine.PlayAudio(1, clip, Mix::AudioSpecification(false, false, 100, 1)));
+		REQUIRE(engine.SetAudioPosition(0, -50, 0, 0));
+		REQUIRE(engine.SetAudioPosition(1, 10, 0, 0));
+
+		// the listener moving makes the other one the furthest, new voices start at the origin
+		REQUIRE(engine.SetListenerPosition(-45, 0, 0));
+		REQUIRE(engine.PlayAudio(2, clip, Mix::AudioSpecification(false, false, 100, 1)));
+
+		engine.Update(0.0f);
+
+		REQUIRE(finished == std::vector{ std::make_pair(uint64_t(1), FinishReason::Stolen) });
+	}
+
+	SECTION("Quietest after the listener and buses changed")
+	{
+		const auto quiet = engine.CreateBus();
+		auto spec = Mix::AudioSpecification(false, false, 100, 1);
+
+		engine.SetVoiceLimit(2, StealPolicy::Quietest);
+
+		REQUIRE(engine.PlayAudio(0, clip, spec));
+		REQUIRE(engine.PlayAudio(1, clip, spec));
+		REQUIRE(engine.SetAudioPosition(0, -10, 0, 0));
+		REQUIRE(engine.SetAudioPosition(1, 10, 0, 0));
+
+		// both were as loud until the listener moved next to the second one
+		REQUIRE(engine.SetListenerPosition(8, 0, 0));
+
+		spec.bus = quiet;
+
+		REQUIRE(engine.PlayAudio(3, clip, spec));
+
+		engine.Update(0.0f);
+
+		REQUIRE(finished == std::vector{ std::make_pair(uint64_t(0), FinishReason::Stolen) });
+
+		// turning the bus down makes its voice the quietest
+		REQUIRE(engine.SetBusVolume(quiet, 1));
+		engine.Update(0.0f);
+
+		REQUIRE(engine.PlayAudio(4, clip, Mix::AudioSpecification(false, false, 100, 1)));
+
+		engine.Update(0.0f);
+
+		REQUIRE(finished.back() == std::make_pair(uint64_t(3), FinishReason::Stolen));
+	}
+
+	SECTION("Paused or virtual victim")
+	{
+		engine.SetVoiceLimit(2, StealPolicy::LowestPriority);
+
+		REQUIRE(engine.PlayAudio(0, clip, Mix::AudioSpecification(false, false, 100, 1, 1)));
+		REQUIRE(engine.PlayAudio(1, clip, Mix::AudioSpecification(false, false, 100, 1, 5)));
+		REQUIRE(engine.PauseAudio(0));
+
+		// nothing to fade, so the victim is removed straight away and the new voice takes its place
+		REQUIRE(engine.PlayAudio(2, clip, Mix::AudioSpecification(false, false, 100, 1, 3)));
+		REQUIRE(engine.EmitterCount() == 2);
+
+		engine.Update(0.0f);
+
+		REQUIRE(finished == std::vector{ std::make_pair(uint64_t(0), FinishReason::Stolen) });
+		REQUIRE(engine.RealEmitterCount() == 2);
+
+		// the new voice still finishes
+		engine.Update(1.0f);
+
+		REQUIRE(engine.EmitterCount() == 0);
+		REQUIRE(finished.size() == 3);
+
+		Mix::AudioEngine single(1, 0);
+		const auto singleClip = single.CreateClip("Clips/Pew.wav", false);
+
+		single.SetVoiceLimit(2, StealPolicy::LowestPriority);
+
+		REQUIRE(single.PlayAudio(0, singleClip, Mix::AudioSpecification(false, false, 100, 1, 5)));
+		REQUIRE(single.PlayAudio(1, singleClip, Mix::AudioSpecification(false, false, 100, 1, 1)));
+		REQUIRE(single.IsAudioVirtual(1));
+		REQUIRE(single.PlayAudio(2, singleClip, Mix::AudioSpecification(false, false, 100, 1, 3)));
+
+		REQUIRE_FALSE(single.GetAudioHandle(1));
+		REQUIRE(single.EmitterCount() == 2);
+
+		single.Update(1.0f);
+
+		REQUIRE(single.EmitterCount() == 0);
+	}
+
+	SECTION("No stealing")
+	{
+		engine.SetVoiceLimit(1, StealPolicy::None);
+
+		REQUIRE(engine.PlayAudio(0, clip, Mix::AudioSpecification(false, false, 100, 1)));
+		REQUIRE_FALSE(engine.PlayAudio(1, clip, Mix::AudioSpecification(false, false, 100, 1)));
+
+		// replaying the same entity stops it first, so it always fits
+		REQUIRE(engine.PlayAudio(0, clip, Mix::AudioSpecification(false, false, 100, 1)));
+
+		engine.Update(0.0f);
+
+		REQUIRE(finished == std::vector{ std::make_pair(uint64_t(0), FinishReason::Stopped) });
+	}
+}
+
+TEST_CASE("Clip playback rules", "[AudioEngine]")
+{
+	using LimitPolicy = Mix::ClipPlaybackRules::LimitPolicy;
+
+	Mix::AudioEngine engine;
+	const auto clip = engine.CreateClip("Clips/Pew.wav", false);
+	const auto spec = Mix::AudioSpecification(false, false, 50, 1);
+	std::vector<uint64_t> stolen;
+
+	engine.SetAudioFinishCallback([&](uint64_t entityID, Mix::AudioEngine::FinishReason reason)
+	{
+		if (reason == Mix::AudioEngine::FinishReason::Stolen) stolen.push_back(entityID);
+	});
+
+	SECTION("Instance limit")
+	{
+		engine.SetClipPlaybackRules(clip, { 2, 0.0f, LimitPolicy::Reject });
+
+		REQUIRE(engine.PlayAudio(0, clip, spec));
+		REQUIRE(engine.PlayAudio(1, clip, spec));
+		REQUIRE_FALSE(engine.PlayAudio(2, clip, spec));
+
+		// stopping one makes room again
+		REQUIRE(engine.StopAudio(0));
+		REQUIRE(engine.PlayAudio(2, clip, spec));
+
+		engine.Update(0.0f);
+
+		REQUIRE(engine.GetStats().GetRejectedPlays(Mix::PlayRejection::ClipLimit) == 1);
+	}
+
+	SECTION("Steal oldest")
+	{
+		engine.SetClipPlaybackRules(clip, { 2, 0.0f, LimitPolicy::StealOldest });
+
+		REQUIRE(engine.PlayAudio(0, clip, spec));
+		REQUIRE(engine.PlayAudio(1, clip, spec));
+		REQUIRE(engine.PlayAudio(2, clip, spec));
+		REQUIRE(engine.PlayAudio(3, clip, spec));
+
+		engine.Update(0.0f);
+
+		REQUIRE(stolen == std::vector<uint64_t>{ 0, 1 });
+
+		// a play rejected for anything else leaves the oldest instance alone
+		const auto other = engine.CreateClip("Clips/Pew.wav", true);
+
+		REQUIRE(engine.PlayAudio(4, other, spec));
+		REQUIRE(engine.PlayAudio(5, other, spec));
+		REQUIRE(engine.SetVoiceLimit(2, Mix::AudioEngine::StealPolicy::None));
+		REQUIRE_FALSE(engine.PlayAudio(6, clip, spec));
+
+		engine.Update(0.0f);
+
+		REQUIRE(stolen == std::vector<uint64_t>{ 0, 1 });
+		REQUIRE(engine.GetAudioHandle(2));
+	}
+
+	SECTION("Boost existing")
+	{
+		engine.SetClipPlaybackRules(clip, { 1, 0.0f, LimitPolicy::BoostExisting, 20.0f });
+
+		REQUIRE(engine.PlayAudio(0, clip, spec));
+		REQUIRE_FALSE(engine.PlayAudio(1, clip, spec));
+		REQUIRE_FALSE(engine.PlayAudio(2, clip, spec));
+
+		// nothing more was played, the first instance just got louder
+		engine.Update(0.0f);
+
+		REQUIRE(engine.EmitterCount() == 1);
+		REQUIRE(engine.GetStats().GetRejectedPlays(Mix::PlayRejection::ClipLimit) == 2);
+	}
+
+	SECTION("Boosting a muted instance")
+	{
+		const auto other = engine.CreateClip("Clips/Pew.wav", true);
+
+		engine.SetClipPlaybackRules(clip, { 1, 0.0f, LimitPolicy::BoostExisting, 20.0f });
+		engine.SetVoiceLimit(2, Mix::AudioEngine::StealPolicy::Quietest);
+
+		REQUIRE(engine.PlayAudio(0, clip, Mix::AudioSpecification(false, true, 50, 1)));
+		REQUIRE_FALSE(engine.PlayAudio(1, clip, spec));
+		REQUIRE(engine.SetAudioMuteState(0, false));
+
+		// the boost survived the mute, so the first instance is no longer the quietest
+		REQUIRE(engine.PlayAudio(2, other, Mix::AudioSpecification(false, false, 60, 1)));
+		REQUIRE(engine.PlayAudio(3, other, Mix::AudioSpecification(false, false, 100, 1)));
+
+		engine.Update(0.0f);
+
+		REQUIRE(stolen == std::vector<uint64_t>{ 2 });
+	}
+
+	SECTION("Retrigger interval")
+	{
+		engine.SetClipPlaybackRules(clip, { 0, 0.1f, LimitPolicy::Reject });
+
+		REQUIRE(engine.PlayAudio(0, clip, spec));
+		REQUIRE_FALSE(engine.PlayAudio(1, clip, spec));
+
+		engine.Update(0.05f);
+		REQUIRE_FALSE(engine.PlayAudio(1, clip, spec));
+
+		engine.Update(0.05f);
+		REQUIRE(engine.PlayAudio(1, clip, spec));
+	}
+
+	SECTION("Rejected plays don't start the retrigger interval")
+	{
+		const auto other = engine.CreateClip("Clips/Pew.wav", true);
+
+		engine.SetClipPlaybackRules(clip, { 0, 0.1f, LimitPolicy::Reject });
+		engine.SetVoiceLimit(1, Mix::AudioEngine::StealPolicy::None);
+
+		REQUIRE(engine.PlayAudio(0, other, spec));
+		REQUIRE_FALSE(engine.PlayAudio(1, clip, spec));
+		REQUIRE(engine.StopAudio(0));
+		REQUIRE(engine.PlayAudio(1, clip, spec));
+	}
+
+	SECTION("Other clips are not limited")
+	{
+		const auto other = engine.CreateClip("Clips/Pew.wav", true);
+
+		engine.SetClipPlaybackRules(clip, { 1, 0.0f, LimitPolicy::Reject });
+
+		REQUIRE(engine.PlayAudio(0, clip, spec));
+		REQUIRE(engine.PlayAudio(1, other, spec));
+		REQUIRE(engine.PlayAudio(2, other, spec));
+	}
+}
+
+TEST_CASE("Syncing a source", "[AudioEngine]")
+{
+	Mix::AudioEngine engine;
+	const auto clip = engine.CreateClip("Clips/Pew.wav", false);
+	auto spec = Mix::AudioSpecification(false, false, 100, 1);
+	constexpr uint64_t entity = 7;
+	float offset = 0.0f;
+
+	REQUIRE_FALSE(engine.SyncSource(entity, spec, offset));
+	REQUIRE(engine.PlayAudio(entity, clip, spec));
+	REQUIRE(engine.SyncSource(entity, spec, offset));
+	REQUIRE(offset == 0.0f);
+
+	// looping moves the stop time, so it keeps playing past the end of the clip
+	spec.loop = true;
+
+	REQUIRE(engine.SyncSource(entity, spec, offset));
+
+	engine.Update(clip.GetDuration() + 0.1f);
+
+	REQUIRE(engine.EmitterCount() == 1);
+
+	// the offset is only sought to when it changes, and is always written back
+	offset = 0.25f;
+
+	REQUIRE(engine.SyncSource(entity, spec, offset));
+	REQUIRE(offset == 0.25f);
+	REQUIRE(engine.GetAudioOffsetTime(entity) == 0.25f);
+
+	// a volume changed while muted is applied once unmuted
+	spec.mute = true;
+	spec.volume = 40;
+
+	REQUIRE(engine.SyncSource(entity, spec, offset));
+
+	spec.mute = false;
+
+	REQUIRE(engine.SyncSource(entity, spec, offset));
+
+	// moving to another bus takes on its pause, and its stops from then on
+	const auto paused = engine.CreateBus();
+
+	REQUIRE(engine.PauseBus(paused));
+	engine.Update(0.0f);
+
+	spec.bus = paused;
+
+	REQUIRE(engine.SyncSource(entity, spec, offset));
+
+	const float pausedAt = engine.GetAudioOffsetTime(entity);
+
+	engine.Update(0.1f);
+
+	REQUIRE(engine.GetAudioOffsetTime(entity) == pausedAt);
+	REQUIRE(engine.StopBus(paused));
+
+	engine.Update(0.0f);
+
+	REQUIRE(engine.EmitterCount() == 0);
+
+	// what the voice plays is what was synced
+	auto render = [](const std::vector<Mix::AudioSpecification>& syncs)
+	{
+		Mix::AudioEngine offline(Mix::AudioEngine::Backend::Offline, 1);
+		const auto pew = offline.CreateClip("Clips/Pew.wav", false);
+		float start = 0.0f;
+
+		REQUIRE(offline.PlayAudio(entity, pew, syncs.front()));
+
+		for (size_t i = 1; i < syncs.size(); i++)
+		{
+			REQUIRE(offline.SyncSource(entity, syncs[i], start));
+		}
+
+		std::vector<sf::Int16> output(4096 * Mix::Mixer::c_ChannelCount);
+
+		REQUIRE(offline.Render(output.data(), 4096));
+
+		return output;
+	};
+
+	const auto audible = Mix::AudioSpecification(false, false, 40, 1);
+	const auto muted = Mix::AudioSpecification(false, true, 40, 1);
+	const auto loud = Mix::AudioSpecification(false, false, 100, 1);
+	const auto quiet = render({ audible });
+
+	REQUIRE(std::any_of(quiet.begin(), quiet.end(), [](sf::Int16 sample) { return sample != 0; }));
+	REQUIRE(render({ loud, muted, audible }) == quiet);
+
+	const auto silent = render({ loud, muted });
+
+	REQUIRE(std::all_of(silent.begin(), silent.end(), [](sf::Int16 sample) { return sample == 0; }));
+}
+
+TEST_CASE("Bulk calls", "[AudioEngine]")
+{
+	Mix::AudioEngine engine;
+	const auto clip = engine.CreateClip("Clips/Pew.wav", false);
+	const std::vector<uint64_t> entities = { 1, 2, 3, 4 };
+	const std::vector<Mix::AudioSpecification> specs(4, Mix::AudioSpecification(false, false, 100, 1));
+
+	// one clip is shared by every entity
+	REQUIRE(engine.PlayAudio(entities, std::span(&clip, 1), specs) == 4);
+	REQUIRE(engine.EmitterCount() == 4);
+
+	const std::vector<float> volumes = { 10, 20, 30, 40 };
+	const std::vector<sf::Vector3f> positions(4, sf::Vector3f(1, 2, 3));
+
+	REQUIRE(engine.SetAudioVolumes(entities, volumes) == 4);
+	REQUIRE(engine.SetAudioPitches(entities, std::vector<float>{ 2, 2 }) == 2); // the shorter span wins
+	REQUIRE(engine.SetAudioPositions(entities, positions) == 4);
+
+	std::vector<float> offsets(4, -1.0f);
+
+	REQUIRE(engine.GetAudioOffsetTimes(entities, offsets) == 4);
+	REQUIRE(offsets == std::vector<float>(4, 0.0f));
+
+	offsets = { 0.1f, 0.2f, 0.3f, 0.4f };
+
+	REQUIRE(engine.SyncSources(entities, specs, offsets) == 4);
+	REQUIRE(offsets[3] == 0.4f);
+
+	// entities that aren't playing are skipped
+	REQUIRE(engine.StopAudio(std::vector<uint64_t>{ 1, 2, 5 }) == 2);
+	REQUIRE(engine.EmitterCount() == 2);
+	REQUIRE(engine.GetAudioOffsetTimes(entities, offsets) == 2);
+	REQUIRE(offsets[0] == 0.0f);
+
+	// handles skip the entity lookup, stale ones are skipped like missing entities
+	const std::vector<Mix::AudioHandle> handles = { engine.GetAudioHandle(3), engine.GetAudioHandle(4), engine.GetAudioHandle(1) };
+
+	REQUIRE(engine.SetAudioVolumes(handles, volumes) == 2);
+	REQUIRE(engine.SetAudioPositions(handles, positions) == 2);
+	REQUIRE(engine.GetAudioOffsetTimes(handles, offsets) == 2);
+	REQUIRE(engine.SyncSources(handles, specs, offsets) == 2);
+	REQUIRE(engine.StopAudio(handles) == 2);
+	REQUIRE(engine.EmitterCount() == 0);
+}
+
+TEST_CASE("Buses", "[AudioEngine]")
+{
+	Mix::AudioEngine engine;
+	const auto clip = engine.CreateClip("Clips/Pew.wav", false);
+	const auto music = engine.CreateBus();
+	const auto battle = engine.CreateBus(music);
+
+	REQUIRE(music != Mix::AudioEngine::c_InvalidBus);
+	REQUIRE(engine.CreateBus(42) == Mix::AudioEngine::c_InvalidBus);
+
+	REQUIRE(engine.PlayAudio(1, clip, Mix::AudioSpecification(false, false, 100, 1, 0, music)));
+	REQUIRE(engine.PlayAudio(2, clip, Mix::AudioSpecification(false, false, 100, 1, 0, battle)));
+	REQUIRE(engine.PlayAudio(3, clip, Mix::AudioSpecification(false, false, 100, 1)));
+
+	// pausing a bus also pauses the buses below it, but only once the engine updates
+	REQUIRE(engine.PauseBus(music));
+	REQUIRE_FALSE(engine.PauseBus(music));
+	REQUIRE(engine.EmitterCount() == 3);
+
+	engine.Update(0);
+
+	REQUIRE(engine.EmitterCount() == 1);
+
+	// joining a paused bus
+	REQUIRE(engine.PlayAudio(4, clip, Mix::AudioSpecification(false, false, 100, 1, 0, battle)));
+	REQUIRE(engine.EmitterCount() == 1);
+
+	REQUIRE(engine.UnpauseBus(music));
+	engine.Update(0);
+
+	REQUIRE(engine.EmitterCount() == 4);
+
+	// stopping only reaches voices that were already playing
+	std::vector<uint64_t> finished;
+	engine.SetAudioFinishCallback([&finished](uint64_t entityID) { finished.push_back(entityID); });
+
+	REQUIRE(engine.StopBus(music));
+	REQUIRE(engine.PlayAudio(5, clip, Mix::AudioSpecification(false, false, 100, 1, 0, battle)));
+
+	engine.Update(0);
+
+	std::sort(finished.begin(), finished.end());
+
+	REQUIRE(finished == std::vector<uint64_t>{ 1, 2, 4 });
+	REQUIRE(engine.EmitterCount() == 2);
+	REQUIRE_FALSE(engine.SetBusVolume(42, 50));
+
+	// a voice unpaused by hand still waits on its bus, and one paused by hand stays paused after the bus
+	REQUIRE(engine.PlayAudio(6, clip, Mix::AudioSpecification(false, false, 100, 1, 0, battle)));
+	REQUIRE(engine.PauseAudio(5));
+	REQUIRE(engine.PauseBus(battle));
+	engine.Update(0);
+
+	REQUIRE(engine.UnpauseAudio(5));
+	REQUIRE(engine.PauseAudio(6));
+	REQUIRE(engine.EmitterCount() == 1);
+
+	REQUIRE(engine.UnpauseBus(battle));
+	engine.Update(0);
+
+	REQUIRE(engine.EmitterCount() == 2);
+	REQUIRE(engine.UnpauseAudio(6));
+	REQUIRE(engine.EmitterCount() == 3);
+}
+
+TEST_CASE("Finish events", "[AudioEngine]")
+{
+	using Reason = Mix::AudioEngine::FinishReason;
+
+	Mix::AudioEngine engine;
+	const auto clip = engine.CreateClip("Clips/Pew.wav", false);
+	const auto spec = Mix::AudioSpecification(false, false, 100, 1);
+
+	engine.PlayAudio(1, clip, spec);
+	engine.PlayAudio(2, clip, spec);
+	engine.PlayAudio(3, clip, spec);
+
+	// restarting an entity stops its old voice first
+	engine.PlayAudio(3, clip, spec);
+	engine.StopAudio(2);
+
+	// nothing is published until the engine updates
+	REQUIRE(engine.GetFinishEvents().empty());
+
+	engine.Update(0);
+
+	auto events = engine.GetFinishEvents();
+
+	REQUIRE(events.size() == 2);
+	REQUIRE(events[0].entity == 3);
+	REQUIRE(events[0].reason == Reason::Stopped);
+	REQUIRE(events[1].entity == 2);
+	REQUIRE(events[1].reason == Reason::Stopped);
+
+	engine.Update(clip.GetDuration() + 0.1f);
+
+	events = engine.GetFinishEvents();
+
+	REQUIRE(events.size() == 2);
+	REQUIRE(events[0].reason == Reason::Finished);
+	REQUIRE(events[1].reason == Reason::Finished);
+
+	// each update replaces the last one's events
+	engine.Update(0);
+
+	REQUIRE(engine.GetFinishEvents().empty());
+}
+
+TEST_CASE("Tick clock", "[AudioEngine]")
+{
+	Mix::AudioEngine engine;
+	const auto clip = engine.CreateClip("Clips/Pew.wav", false);
+	const uint32_t rate = engine.GetTickRate();
+
+	// fractions of a tick are carried over instead of lost
+	for (int i = 0; i < 60; i++) engine.Update(1.0f / 60.0f);
+
+	REQUIRE(engine.GetCurrentTick() == rate);
+
+	// days of uptime don't cost the deadlines any precision
+	engine.Update(3 * 24 * 60 * 60.0f);
+
+	const uint64_t start = engine.GetCurrentTick();
+
+	REQUIRE(engine.PlayAudio(1, clip, Mix::AudioSpecification(false, false, 100, 1)));
+	REQUIRE(engine.PlayAudio(2, clip, Mix::AudioSpecification(true, false, 100, 1)));
+
+	const auto clipTicks = static_cast<uint64_t>(std::llround(static_cast<double>(clip.GetDuration()) * rate));
+
+	engine.Update(static_cast<float>(clipTicks - 2) / static_cast<float>(rate));
+
+	REQUIRE(engine.GetCurrentTick() - start < clipTicks);
+	REQUIRE(engine.EmitterCount() == 2);
+
+	engine.Update(4.0f / static_cast<float>(rate));
+
+	// the loop has no deadline
+	REQUIRE(engine.EmitterCount() == 1);
+	REQUIRE(engine.StopAudio(2));
+}
+
+TEST_CASE("Scheduled playback", "[AudioEngine]")
+{
+	Mix::AudioEngine engine;
+	const auto clip = engine.CreateClip("Clips/Pew.wav", false);
+	const auto spec = Mix::AudioSpecification(false, false, 100, 1);
+	const uint64_t second = engine.GetTickRate();
+
+	REQUIRE(engine.PlayAudioAt(1, clip, spec, second));
+	REQUIRE(engine.PlayAudioAt(2, clip, spec, second * 2));
+	REQUIRE(engine.PlayAudioAt(3, clip, spec, second * 3));
+
+	// the entity owns the play before it starts
+	REQUIRE(engine.StopAudio(3));
+	REQUIRE(engine.EmitterCount() == 0);
+
+	engine.Update(0.5f);
+
+	REQUIRE(engine.EmitterCount() == 0);
+
+	// started late, so it skips ahead by however late it was
+	engine.Update(0.75f);
+
+	REQUIRE(engine.EmitterCount() == 1);
+	REQUIRE(std::abs(engine.GetAudioOffsetTime(1) - 0.25f) <= 0.01f);
+
+	engine.Update(1.0f);
+
+	REQUIRE(engine.EmitterCount() == 1);
+	REQUIRE(engine.StopAudioAt(2, engine.GetCurrentTick() + 10));
+
+	engine.Update(0.5f);
+
+	REQUIRE(engine.EmitterCount() == 0);
+	REQUIRE(engine.GetFinishEvents().size() == 1);
+	REQUIRE(engine.GetFinishEvents()[0].reason == Mix::AudioEngine::FinishReason::Stopped);
+}
@@ -1,6 +1,9 @@
 #include <catch2/catch_test_macros.hpp>
 #include <MaizeMix.h>
 
+#include <filesystem>
+#include <thread>
+
 Mix::AudioManager g_Manager;
 Mix::AudioClip g_AudioClip;
 
@@ -41,4 +44,97 @@ TEST_CASE("Audio clip error")
 	REQUIRE(error.IsLoadInBackground() == false);
 	REQUIRE(error.GetSampleCount() == 0);
 	REQUIRE(g_AudioClip.IsValid() == false);
+}
+
+TEST_CASE("Audio clip cache")
+{
+	auto first = g_Manager.CreateClip("Clips/Pew.wav", false);
+	auto second = g_Manager.CreateClip("Clips/Pew.wav", false);
+	auto streamed = g_Manager.CreateClip("Clips/Pew.wav", true);
+
+	// the same path and load mode share one clip
+	REQUIRE(g_Manager.GetClipCount() == 2);
+	REQUIRE(g_Manager.GetReferenceCount(first) == 2);
+	REQUIRE(g_Manager.GetReferenceCount(streamed) == 1);
+	REQUIRE(first.GetMemoryUsage() == 23460 * sizeof(int16_t));
+	REQUIRE(streamed.GetMemoryUsage() == std::filesystem::file_size("Clips/Pew.wav")); // mapped, not decoded
+	REQUIRE(g_Manager.GetMemoryUsage() == first.GetMemoryUsage() + streamed.GetMemoryUsage());
+
+	g_Manager.DestroyClip(first);
+
+	REQUIRE(second.IsValid() == true);
+	REQUIRE(g_Manager.GetReferenceCount(second) == 1);
+
+	g_Manager.DestroyClip(second);
+	g_Manager.DestroyClip(streamed);
+
+	REQUIRE(g_Manager.GetClipCount() == 0);
+	REQUIRE(g_Manager.GetMemoryUsage() == 0);
+}
+
+TEST_CASE("Audio clip create async")
+{
+	auto clip = g_Manager.CreateClipAsync("Clips/Pew.wav", false);
+
+	REQUIRE(clip.IsValid() == true);
+
+	while (clip.GetLoadState() == Mix::AudioClip::LoadState::Unloaded)
+	{
+		std::this_thread::yield();
+	}
+
+	REQUIRE(clip.GetLoadState() == Mix::AudioClip::LoadState::Loaded);
+	REQUIRE(clip.GetChannel() == 1);
+	REQUIRE(clip.GetFrequency() == 44100);
+	REQUIRE(clip.GetSampleCount() == 23460);
+
+	g_Manager.DestroyClip(clip);
+}
+
+TEST_CASE("Audio clip error async")
+{
+	auto error = g_Manager.CreateClipAsync("error test", true);
+
+	while (error.GetLoadState() == Mix::AudioClip::LoadState::Unloaded)
+	{
+		std::this_thread::yield();
+	}
+
+	REQUIRE(error.GetLoadState() == Mix::AudioClip::LoadState::Failed);
+	REQUIRE(error.IsLoadInBackground() == true);
+	REQUIRE(error.GetDuration() == 0.0f);
+	REQUIRE(error.GetSampleCount() == 0);
+
+	g_Manager.DestroyClip(error);
+}
+
+TEST_CASE("Audio clip stream")
+{
+	auto clip = g_Manager.CreateClip("Clips/Pew.wav", true);
+
+	// streamed clips read their header from the mapped file
+	REQUIRE(clip.GetChannel() == 1);
+	REQUIRE(clip.GetFrequency() == 44100);
+	REQUIRE(clip.GetSampleCount() == 23460);
+	REQUIRE(clip.IsLoadInBackground() == true);
+
+	g_Manager.DestroyClip(clip);
+}
+
+TEST_CASE("Audio clip compressed")
+{
+	auto clip = g_Manager.CreateClip("Clips/Pew.wav", Mix::AudioClip::LoadType::CompressedInMemory);
+
+	// the encoded file is kept as is, and decoded while it plays
+	REQUIRE(clip.GetLoadState() == Mix::AudioClip::LoadState::Loaded);
+	REQUIRE(clip.GetLoadType() == Mix::AudioClip::LoadType::CompressedInMemory);
+	REQUIRE(clip.IsLoadInBackground() == true);
+	REQUIRE(clip.GetSampleCount() == 23460);
+	REQUIRE(clip.GetMemoryUsage() == std::filesystem::file_size("Clips/Pew.wav"));
+
+	g_Manager.DestroyClip(clip);
+
+	auto error = g_Manager.CreateClip("error test", Mix::AudioClip::LoadType::CompressedInMemory);
+
+	REQUIRE(error.GetLoadState() == Mix::AudioClip::LoadState::Failed);
 }
\ No newline at end of file
@@ -0,0 +1,147 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include "MaizeMix/Helper/Kernels/MixKernels.h"
+
+#include <random>
+#include <vector>
+#include <cmath>
+
+namespace {
+
+	// odd so every vector kernel also runs its scalar tail
+	constexpr size_t c_Count = 1027;
+	constexpr float c_Tolerance = 1e-5f;
+
+	std::vector<int16_t> RandomSamples(size_t count)
+	{
+		std::mt19937 random(42);
+		std::uniform_int_distribution<int> distribution(-32768, 32767);
+		std::vector<int16_t> samples(count);
+
+		for (auto& sample : samples) sample = static_cast<int16_t>(distribution(random));
+
+		return samples;
+	}
+
+	std::vector<float> RandomFloats(size_t count, float range = 1.0f)
+	{
+		std::mt19937 random(7);
+		std::uniform_real_distribution<float> distribution(-range, range);
+		std::vector<float> samples(count);
+
+		for (auto& sample : samples) sample = distribution(random);
+
+		return samples;
+	}
+
+	void RequireNear(const std::vector<float>& actual, const std::vector<float>& expected)
+	{
+		REQUIRE(actual.size() == expected.size());
+
+		for (size_t i = 0; i < actual.size(); i++)
+		{
+			REQUIRE(std::abs(actual[i] - expected[i]) <= c_Tolerance);
+		}
+	}
+
+	std::vector<const Mix::MixKernels*> AvailableKernels()
+	{
+		std::vector<const Mix::MixKernels*> kernels;
+
+		for (auto instructionSet : { Mix::InstructionSet::SSE2, Mix::InstructionSet::AVX2, Mix::InstructionSet::NEON })
+		{
+			if (const auto* table = Mix::GetMixKernels(instructionSet)) kernels.push_back(table);
+		}
+
+		return kernels;
+	}
+
+}
+
+TEST_CASE("Kernel dispatch", "[MixKernels]")
+{
+	REQUIRE(Mix::GetMixKernels(Mix::InstructionSet::Scalar) != nullptr);
+	REQUIRE(Mix::GetMixKernels(Mix::GetMixInstructionSet()) == &Mix::GetMixKernels());
+}
+
+TEST_CASE("Kernels match scalar", "[MixKernels]")
+{
+	const Mix::MixKernels& scalar = *Mix::GetScalarKernels();
+	const auto samples = RandomSamples(c_Count * 2);
+	const auto input = RandomFloats(c_Count * 2 + 4);
+
+	const auto available = AvailableKernels();
+
+	for (size_t k = 0; k < available.size(); k++)
+	{
+		const auto* kernels = available[k];
+
+		DYNAMIC_SECTION("Convert " << k)
+		{
+			std::vector<float> expected(c_Count), actual(c_Count);
+
+			scalar.ConvertToFloat(expected.data(), samples.data(), c_Count);
+			kernels->ConvertToFloat(actual.data(), samples.data(), c_Count);
+
+			RequireNear(actual, expected);
+		}
+
+		DYNAMIC_SECTION("Deinterleave " << k)
+		{
+			std::vector<float> expectedLeft(c_Count), expectedRight(c_Count), actualLeft(c_Count), actualRight(c_Count);
+
+			scalar.DeinterleaveToFloat(expectedLeft.data(), expectedRight.data(), samples.data(), c_Count);
+			kernels->DeinterleaveToFloat(actualLeft.data(), actualRight.data(), samples.data(), c_Count);
+
+			RequireNear(actualLeft, expectedLeft);
+			RequireNear(actualRight, expectedRight);
+		}
+
+		DYNAMIC_SECTION("Resample " << k)
+		{
+			for (float step : { 1.0f, 0.75f, 1.5f })
+			{
+				std::vector<float> expected(c_Count), actual(c_Count);
+
+				scalar.ResampleLinear(expected.data(), input.data(), c_Count, 1.25f, step);
+				kernels->ResampleLinear(actual.data(), input.data(), c_Count, 1.25f, step);
+
+				RequireNear(actual, expected);
+
+				scalar.ResampleCubic(expected.data(), input.data(), c_Count, 1.25f, step);
+				kernels->ResampleCubic(actual.data(), input.data(), c_Count, 1.25f, step);
+
+				RequireNear(actual, expected);
+			}
+		}
+
+		DYNAMIC_SECTION("Mix " << k)
+		{
+			auto expectedLeft = RandomFloats(c_Count), expectedRight = RandomFloats(c_Count);
+			auto actualLeft = expectedLeft, actualRight = expectedRight;
+
+			scalar.MixGain(expectedLeft.data(), input.data(), c_Count, 0.5f, 0.0001f);
+			kernels->MixGain(actualLeft.data(), input.data(), c_Count, 0.5f, 0.0001f);
+
+			RequireNear(actualLeft, expectedLeft);
+
+			scalar.MixPanned(expectedLeft.data(), expectedRight.data(), input.data(), c_Count, 0.25f, 0.75f, 0.0002f, -0.0002f);
+			kernels->MixPanned(actualLeft.data(), actualRight.data(), input.data(), c_Count, 0.25f, 0.75f, 0.0002f, -0.0002f);
+
+			RequireNear(actualLeft, expectedLeft);
+			RequireNear(actualRight, expectedRight);
+		}
+
+		DYNAMIC_SECTION("Interleave " << k)
+		{
+			// past full scale so clamping is covered too
+			const auto left = RandomFloats(c_Count, 1.5f), right = RandomFloats(c_Count, 1.5f);
+			std::vector<int16_t> expected(c_Count * 2), actual(c_Count * 2);
+
+			scalar.InterleaveToInt16(expected.data(), left.data(), right.data(), c_Count);
+			kernels->InterleaveToInt16(actual.data(), left.data(), right.data(), c_Count);
+
+			REQUIRE(actual == expected);
+		}
+	}
+}
\ No newline at end of file
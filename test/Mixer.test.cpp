@@ -0,0 +1,523 @@
+#include <catch2/catch_test_macros.hpp>
+#include <MaizeMix.h>
+
+#include "MaizeMix/Helper/AudioClips/CompressedBuffer.h"
+#include "MaizeMix/Helper/AudioClips/SoundBuffer.h"
+#include "MaizeMix/Helper/Mixer.h"
+
+#include <vector>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <thread>
+
+namespace {
+
+	// frames of Clips/Pew.wav, a 44100hz mono clip
+	constexpr size_t c_ClipFrames = 23460;
+
+	std::shared_ptr<Mix::SoundBuffer> LoadBuffer()
+	{
+		auto buffer = std::make_shared<Mix::SoundBuffer>();
+
+		REQUIRE(buffer->OpenFromFile("Clips/Pew.wav"));
+
+		return buffer;
+	}
+
+	std::vector<sf::Int16> MixFrames(Mix::Mixer& mixer, size_t frames, size_t blockFrames = 512)
+	{
+		std::vector<sf::Int16> output(frames * Mix::Mixer::c_ChannelCount);
+
+		for (size_t done = 0; done < frames; done += blockFrames)
+		{
+			const size_t count = std::min(blockFrames, frames - done);
+
+			mixer.Mix(output.data() + done * Mix::Mixer::c_ChannelCount, count);
+		}
+
+		return output;
+	}
+
+	// waits until the decode workers have filled the voice's stream ahead of it
+	void WaitForPrefetch(const Mix::MixerVoice& voice)
+	{
+		const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+
+		while (voice.getBufferedTime() < 0.25f && std::chrono::steady_clock::now() < deadline)
+		{
+			std::this_thread::sleep_for(std::chrono::milliseconds(1));
+		}
+
+		REQUIRE(voice.getBufferedTime() >= 0.25f);
+	}
+
+	bool IsSilent(const std::vector<sf::Int16>& samples)
+	{
+		return std::all_of(samples.begin(), samples.end(), [](sf::Int16 sample) { return sample == 0; });
+	}
+
+}
+
+TEST_CASE("Mixing silence", "[Mixer]")
+{
+	Mix::Mixer mixer(4);
+
+	REQUIRE(IsSilent(MixFrames(mixer, 1024)));
+}
+
+TEST_CASE("Mixing a sound", "[Mixer]")
+{
+	Mix::Mixer mixer(4);
+	const auto buffer = LoadBuffer();
+	auto* voice = mixer.GetVoices().Acquire();
+
+	voice->setBuffer(buffer);
+	voice->play();
+
+	const auto output = MixFrames(mixer, 1024);
+	const sf::Int16* samples = buffer->GetBuffer().getSamples();
+
+	// a centered mono clip lands equally in both channels, after the fade in of the first block
+	for (size_t i = 512; i < 1024; i++)
+	{
+		const float expected = static_cast<float>(samples[i]) * std::sqrt(0.5f);
+
+		REQUIRE(std::abs(output[i * 2] - expected) <= 1.0f);
+		REQUIRE(output[i * 2] == output[i * 2 + 1]);
+	}
+
+	REQUIRE(voice->getPlayingOffset().asSeconds() >= 1023.0f / 44100.0f);
+}
+
+TEST_CASE("Mixed sound finishing", "[Mixer]")
+{
+	Mix::Mixer mixer(4);
+	const auto buffer = LoadBuffer();
+	auto* voice = mixer.GetVoices().Acquire();
+
+	voice->setBuffer(buffer);
+	voice->play();
+
+	MixFrames(mixer, c_ClipFrames + 512);
+
+	REQUIRE(voice->getStatus() == sf::SoundSource::Stopped);
+	REQUIRE(IsSilent(MixFrames(mixer, 512)));
+}
+
+TEST_CASE("Mixed sound looping", "[Mixer]")
+{
+	Mix::Mixer mixer(4);
+	const auto buffer = LoadBuffer();
+	auto* voice = mixer.GetVoices().Acquire();
+
+	voice->setBuffer(buffer);
+	voice->setLoop(true);
+	voice->play();
+
+	MixFrames(mixer, c_ClipFrames * 2 + 100);
+
+	REQUIRE(voice->getStatus() == sf::SoundSource::Playing);
+	REQUIRE(voice->getPlayingOffset().asSeconds() < 200.0f / 44100.0f);
+}
+
+TEST_CASE("Mixed sound bus", "[Mixer]")
+{
+	Mix::Mixer mixer(4);
+	const auto buffer = LoadBuffer();
+	auto* voice = mixer.GetVoices().Acquire();
+
+	voice->setBuffer(buffer);
+	voice->setBus(1);
+	voice->play();
+
+	// a paused bus holds its voices where they are
+	mixer.SetBuses({ {}, { 1.0f, true } });
+
+	REQUIRE(IsSilent(MixFrames(mixer, 1024)));
+	REQUIRE(voice->getPlayingOffset() == sf::Time::Zero);
+
+	// the bus gain is applied on top of the voice volume
+	mixer.SetBuses({ {}, { 0.0f, false } });
+
+	REQUIRE(IsSilent(MixFrames(mixer, 1024)));
+	REQUIRE(voice->getPlayingOffset().asSeconds() >= 1023.0f / 44100.0f);
+}
+
+TEST_CASE("Mixed sound pitch", "[Mixer]")
+{
+	Mix::Mixer mixer(4);
+	const auto buffer = LoadBuffer();
+	auto* voice = mixer.GetVoices().Acquire();
+
+	voice->setBuffer(buffer);
+	voice->setPitch(2.0f);
+	voice->play();
+
+	// twice the pitch gets through the clip in half the time
+	MixFrames(mixer, c_ClipFrames / 2 + 1);
+
+	REQUIRE(voice->getStatus() == sf::SoundSource::Stopped);
+}
+
+TEST_CASE("Mixed sound cubic interpolation", "[Mixer]")
+{
+	const auto buffer = LoadBuffer();
+
+	auto mixWith = [&](Mix::Mixer::Interpolation interpolation, float pitch)
+	{
+		Mix::Mixer mixer(4);
+		auto* voice = mixer.GetVoices().Acquire();
+
+		mixer.SetInterpolation(interpolation);
+		voice->setBuffer(buffer);
+		voice->setPitch(pitch);
+		voice->play();
+
+		return MixFrames(mixer, 2048);
+	};
+
+	// on whole frames both read the clip as is
+	REQUIRE(mixWith(Mix::Mixer::Interpolation::Cubic, 1.0f) == mixWith(Mix::Mixer::Interpolation::Linear, 1.0f));
+
+	const auto cubic = mixWith(Mix::Mixer::Interpolation::Cubic, 0.75f);
+
+	REQUIRE_FALSE(IsSilent(cubic));
+	REQUIRE(cubic != mixWith(Mix::Mixer::Interpolation::Linear, 0.75f));
+}
+
+TEST_CASE("Mixed stream matches sound", "[Mixer]")
+{
+	const auto buffer = LoadBuffer();
+	auto compressed = std::make_shared<Mix::CompressedBuffer>();
+
+	REQUIRE(compressed->OpenFromFile("Clips/Pew.wav"));
+
+	for (const float pitch : { 1.0f, 0.75f, 1.5f })
+	{
+		Mix::Mixer soundMixer(1);
+		Mix::Mixer streamMixer(1);
+		auto* sound = soundMixer.GetVoices().Acquire();
+		auto* stream = streamMixer.GetVoices().Acquire();
+
+		sound->setBuffer(buffer);
+		REQUIRE(stream->setSoundReference(compressed));
+
+		for (auto* voice : { sound, stream })
+		{
+			voice->setPitch(pitch);
+			voice->setLoop(true);
+			voice->play();
+		}
+
+		// decoding in windows has to give the same result as reading the whole clip, across loops too
+		REQUIRE(MixFrames(soundMixer, c_ClipFrames * 2, 480) == MixFrames(streamMixer, c_ClipFrames * 2, 480));
+	}
+}
+
+TEST_CASE("Mixed sound panning", "[Mixer]")
+{
+	Mix::Mixer mixer(4);
+	const auto buffer = LoadBuffer();
+	auto* voice = mixer.GetVoices().Acquire();
+
+	voice->setBuffer(buffer);
+	voice->setPosition(sf::Vector3f(10.0f, 0.0f, 0.0f));
+	voice->play();
+
+	const auto output = MixFrames(mixer, 4096);
+
+	// fully to the right, and quieter with distance
+	for (size_t i = 0; i < 4096; i++)
+	{
+		REQUIRE(std::abs(output[i * 2]) <= 1);
+	}
+
+	REQUIRE_FALSE(IsSilent(output));
+}
+
+TEST_CASE("Removed clip stops mixing", "[Mixer]")
+{
+	Mix::Mixer mixer(4);
+	auto buffer = LoadBuffer();
+	auto* voice = mixer.GetVoices().Acquire();
+
+	voice->setBuffer(buffer);
+	voice->play();
+	buffer.reset();
+
+	REQUIRE(IsSilent(MixFrames(mixer, 512)));
+	REQUIRE(voice->getStatus() == sf::SoundSource::Stopped);
+}
+
+TEST_CASE("Mixer backend", "[Mixer]")
+{
+	Mix::AudioEngine engine(Mix::AudioEngine::Backend::Mixer, 2);
+	const auto sound = engine.CreateClip("Clips/Pew.wav", false);
+	const auto stream = engine.CreateClip("Clips/Pew.wav", true);
+	const auto spec = Mix::AudioSpecification(false, false, 100, 1);
+
+	REQUIRE(engine.GetBackend() == Mix::AudioEngine::Backend::Mixer);
+
+	// sounds and streams share the mixer voices
+	REQUIRE(engine.PlayAudio(0, sound, spec));
+	REQUIRE(engine.PlayAudio(1, stream, spec));
+	REQUIRE(engine.PlayAudio(2, sound, spec));
+	REQUIRE(engine.RealEmitterCount() == 2);
+	REQUIRE(engine.VirtualEmitterCount() == 1);
+	REQUIRE(engine.HasHitMaxAudioSources() == true);
+
+	REQUIRE(engine.PauseAudio(0) == true);
+	REQUIRE(engine.StopAudio(1) == true);
+
+	engine.Update(0.0f);
+
+	REQUIRE(engine.IsAudioVirtual(2) == false);
+	REQUIRE(engine.EmitterCount() == 1);
+}
+
+
+TEST_CASE("Offline backend", "[Mixer]")
+{
+	auto render = [](std::vector<uint64_t>& finished)
+	{
+		Mix::AudioEngine engine(Mix::AudioEngine::Backend::Offline, 4);
+		const auto clip = engine.CreateClip("Clips/Pew.wav", false);
+
+		engine.SetAudioFinishCallback([&finished](uint64_t entityID) { finished.push_back(entityID); });
+
+		REQUIRE(engine.GetOutputSampleRate() == 44100);
+		REQUIRE(engine.PlayAudio(0, clip, Mix::AudioSpecification(false, false, 100, 1)));
+
+		std::vector<sf::Int16> output((c_ClipFrames + 1024) * Mix::Mixer::c_ChannelCount);
+
+		REQUIRE(engine.Render(output.data(), c_ClipFrames + 1024));
+		REQUIRE(engine.EmitterCount() == 0);
+
+		return output;
+	};
+
+	std::vector<uint64_t> finished;
+	const auto output = render(finished);
+
+	// the engine clock follows what was rendered, so the clip finishes on its own
+	REQUIRE_FALSE(IsSilent(output));
+	REQUIRE(finished == std::vector<uint64_t>{ 0 });
+
+	// nothing depends on the wall clock
+	REQUIRE(render(finished) == output);
+}
+
+TEST_CASE("Offline backend bus volume", "[Mixer]")
+{
+	auto render = [](float musicVolume, float battleVolume)
+	{
+		Mix::AudioEngine engine(Mix::AudioEngine::Backend::Offline, 4);
+		const auto clip = engine.CreateClip("Clips/Pew.wav", false);
+		const auto music = engine.CreateBus();
+		const auto battle = engine.CreateBus(music);
+
+		engine.SetBusVolume(music, musicVolume);
+		engine.SetBusVolume(battle, battleVolume);
+		engine.Update(0);
+
+		REQUIRE(engine.PlayAudio(0, clip, Mix::AudioSpecification(false, false, 100, 1, 0, battle)));
+
+		std::vector<sf::Int16> output(4096 * Mix::Mixer::c_ChannelCount);
+
+		REQUIRE(engine.Render(output.data(), 4096));
+
+		return output;
+	};
+
+	// the volume of every bus above the voice is applied
+	REQUIRE(IsSilent(render(0, 100)));
+	REQUIRE(IsSilent(render(100, 0)));
+	REQUIRE(render(100, 100) == render(100, 100));
+
+	const auto full = render(100, 100);
+	const auto half = render(50, 100);
+
+	REQUIRE_FALSE(IsSilent(half));
+
+	for (size_t i = 1024; i < full.size(); i++)
+	{
+		REQUIRE(std::abs(full[i] / 2 - half[i]) <= 1);
+	}
+}
+
+TEST_CASE("Offline backend rendering to file", "[Mixer]")
+{
+	Mix::AudioEngine engine(Mix::AudioEngine::Backend::Offline, 4);
+	const auto clip = engine.CreateClip("Clips/Pew.wav", false);
+
+	REQUIRE(engine.PlayAudio(0, clip, Mix::AudioSpecification(false, false, 100, 1)));
+	REQUIRE(engine.RenderToFile("Clips/Offline.wav", 0.25f));
+
+	sf::InputSoundFile file;
+
+	REQUIRE(file.openFromFile("Clips/Offline.wav"));
+	REQUIRE(file.getChannelCount() == Mix::Mixer::c_ChannelCount);
+	REQUIRE(file.getSampleCount() == 11025 * Mix::Mixer::c_ChannelCount);
+
+	file.close();
+	std::remove("Clips/Offline.wav");
+
+	// only the offline backend can be rendered
+	Mix::AudioEngine mixer(Mix::AudioEngine::Backend::Mixer, 4);
+	sf::Int16 frame[Mix::Mixer::c_ChannelCount];
+
+	REQUIRE_FALSE(mixer.Render(frame, 1));
+}
+
+TEST_CASE("Offline backend finish events", "[Mixer]")
+{
+	Mix::AudioEngine engine(Mix::AudioEngine::Backend::Offline, 4);
+	const auto clip = engine.CreateClip("Clips/Pew.wav", false);
+	std::vector<sf::Int16> output(c_ClipFrames * 2 * Mix::Mixer::c_ChannelCount);
+
+	REQUIRE(engine.PlayAudio(0, clip, Mix::AudioSpecification(false, false, 100, 1)));
+	REQUIRE(engine.Render(output.data(), c_ClipFrames * 2));
+
+	// it finished half way through, not in the last block
+	const auto events = engine.GetFinishEvents();
+
+	REQUIRE(events.size() == 1);
+	REQUIRE(events[0].entity == 0);
+	REQUIRE(events[0].reason == Mix::AudioEngine::FinishReason::Finished);
+	REQUIRE(engine.GetStats().voicesStarted == 1);
+	REQUIRE(engine.GetStats().voicesFinished == 1);
+}
+
+TEST_CASE("Offline backend clock", "[Mixer]")
+{
+	Mix::AudioEngine engine(Mix::AudioEngine::Backend::Offline, 4);
+	std::vector<sf::Int16> output(1000 * Mix::Mixer::c_ChannelCount);
+
+	REQUIRE(engine.GetTickRate() == engine.GetOutputSampleRate());
+	REQUIRE(engine.Render(output.data(), 1000));
+
+	// the engine follows the frames that were actually mixed
+	REQUIRE(engine.GetCurrentTick() == 1000);
+
+	// nothing was mixed since
+	engine.Update();
+
+	REQUIRE(engine.GetCurrentTick() == 1000);
+}
+
+
+TEST_CASE("Offline backend scheduled playback", "[Mixer]")
+{
+	Mix::AudioEngine engine(Mix::AudioEngine::Backend::Offline, 4);
+	const auto clip = engine.CreateClip("Clips/Pew.wav", false);
+	const auto spec = Mix::AudioSpecification(false, false, 100, 1);
+	constexpr uint64_t entity = 3;
+
+	std::vector<Mix::AudioEngine::FinishReason> reasons;
+	engine.SetAudioFinishCallback([&reasons](uint64_t, Mix::AudioEngine::FinishReason reason) { reasons.push_back(reason); });
+
+	// far enough out that the voice is only handed over part way through rendering
+	REQUIRE(engine.PlayAudioAt(entity, clip, spec, 10001));
+	REQUIRE(engine.StopAudioAt(entity, 15003));
+	REQUIRE(engine.EmitterCount() == 0);
+
+	std::vector<sf::Int16> output(20000 * Mix::Mixer::c_ChannelCount);
+
+	REQUIRE(engine.Render(output.data(), 20000));
+
+	const auto frame = [&output](size_t index) { return std::vector<sf::Int16>(output.begin() + index * 2, output.begin() + index * 2 + 2); };
+	const auto silent = [&](size_t first, size_t last)
+	{
+		return std::all_of(output.begin() + first * 2, output.begin() + last * 2, [](sf::Int16 sample) { return sample == 0; });
+	};
+
+	// starts and stops on the exact frames, whatever block they land in
+	REQUIRE(silent(0, 10001));
+	REQUIRE_FALSE(silent(10001, 10101));
+	REQUIRE(frame(15002) != std::vector<sf::Int16>{ 0, 0 });
+	REQUIRE(silent(15003, 20000));
+
+	REQUIRE(reasons == std::vector<Mix::AudioEngine::FinishReason>{ Mix::AudioEngine::FinishReason::Stopped });
+	REQUIRE(engine.EmitterCount() == 0);
+}
+
+
+TEST_CASE("Mixed stream with decode workers", "[Mixer]")
+{
+	const auto buffer = LoadBuffer();
+	auto compressed = std::make_shared<Mix::CompressedBuffer>();
+
+	REQUIRE(compressed->OpenFromFile("Clips/Pew.wav"));
+
+	Mix::Mixer soundMixer(1);
+	Mix::Mixer streamMixer(1);
+	auto* sound = soundMixer.GetVoices().Acquire();
+	auto* stream = streamMixer.GetVoices().Acquire();
+
+	streamMixer.EnableStreamDecoding(1);
+
+	sound->setBuffer(buffer);
+	REQUIRE(stream->setSoundReference(compressed));
+	REQUIRE(streamMixer.GetStreamDecoder()->GetStreamCount() == 1);
+
+	for (auto* voice : { sound, stream })
+	{
+		voice->setLoop(true);
+	}
+
+	WaitForPrefetch(*stream);
+
+	for (auto* voice : { sound, stream })
+	{
+		voice->play();
+	}
+
+	// paced well below real time, so the worker keeps up and the output matches decoding while mixing
+	std::vector<sf::Int16> expected, actual;
+
+	for (size_t block = 0; block < 60; block++)
+	{
+		const auto soundBlock = MixFrames(soundMixer, 1024);
+		const auto streamBlock = MixFrames(streamMixer, 1024);
+
+		expected.insert(expected.end(), soundBlock.begin(), soundBlock.end());
+		actual.insert(actual.end(), streamBlock.begin(), streamBlock.end());
+
+		std::this_thread::sleep_for(std::chrono::milliseconds(5));
+	}
+
+	REQUIRE(stream->getUnderruns() == 0);
+	REQUIRE(actual == expected);
+
+	stream->resetBuffer();
+
+	REQUIRE(streamMixer.GetStreamDecoder()->GetStreamCount() == 0);
+}
+
+TEST_CASE("Starting a prefetched stream", "[Mixer]")
+{
+	auto compressed = std::make_shared<Mix::CompressedBuffer>();
+
+	REQUIRE(compressed->OpenFromFile("Clips/Pew.wav"));
+
+	Mix::Mixer mixer(1);
+	auto* voice = mixer.GetVoices().Acquire();
+
+	mixer.EnableStreamDecoding(1);
+
+	REQUIRE(voice->setSoundReference(compressed));
+
+	WaitForPrefetch(*voice);
+
+	// starting reads what the workers decoded instead of flushing it and waiting on a refill
+	voice->play();
+
+	const auto block = MixFrames(mixer, 512);
+
+	REQUIRE(voice->getUnderruns() == 0);
+	REQUIRE_FALSE(IsSilent(block));
+	REQUIRE(voice->getBufferedTime() > 0.25f - 512.0f / 44100.0f - 0.01f);
+
+	voice->resetBuffer();
+}
\ No newline at end of file
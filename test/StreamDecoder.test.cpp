@@ -0,0 +1,170 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include "MaizeMix/Helper/AudioClips/CompressedBuffer.h"
+#include "MaizeMix/Helper/AudioClips/SoundBuffer.h"
+#include "MaizeMix/Helper/StreamDecoder.h"
+
+#include <chrono>
+#include <thread>
+#include <vector>
+
+namespace {
+
+	// frames of Clips/Pew.wav, a 44100hz mono clip
+	constexpr size_t c_ClipFrames = 23460;
+
+	std::shared_ptr<Mix::CompressedBuffer> LoadCompressed()
+	{
+		auto compressed = std::make_shared<Mix::CompressedBuffer>();
+
+		REQUIRE(compressed->OpenFromFile("Clips/Pew.wav"));
+
+		return compressed;
+	}
+
+	std::vector<sf::Int16> LoadSamples()
+	{
+		Mix::SoundBuffer buffer;
+
+		REQUIRE(buffer.OpenFromFile("Clips/Pew.wav"));
+
+		const auto& samples = buffer.GetBuffer();
+
+		return std::vector<sf::Int16>(samples.getSamples(), samples.getSamples() + samples.getSampleCount());
+	}
+
+	std::vector<sf::Int16> Read(Mix::DecodeStream& stream, size_t frames)
+	{
+		std::vector<sf::Int16> samples(frames);
+
+		samples.resize(stream.Read(samples.data(), frames));
+
+		return samples;
+	}
+
+}
+
+TEST_CASE("Decode stream", "[StreamDecoder]")
+{
+	const auto compressed = LoadCompressed();
+	const auto samples = LoadSamples();
+	Mix::DecodeStream stream;
+
+	REQUIRE(stream.Open(compressed));
+
+	// nothing is decoded until something refills it
+	REQUIRE(Read(stream, 100).empty());
+	REQUIRE(stream.Refill(100) == 100);
+	REQUIRE(stream.GetBufferedTime() > 0.0f);
+	REQUIRE(Read(stream, 200) == std::vector<sf::Int16>(samples.begin(), samples.begin() + 100));
+
+	// seeking is carried out by the next refill, nothing from before it is read in the meantime
+	stream.Seek(1000);
+
+	REQUIRE(Read(stream, 50).empty());
+	REQUIRE_FALSE(stream.IsFinished());
+	REQUIRE(stream.NeedsRefill());
+	REQUIRE(stream.GetBufferedTime() == 0.0f);
+	REQUIRE(stream.Refill(100) == 100);
+	REQUIRE(Read(stream, 50) == std::vector<sf::Int16>(samples.begin() + 1000, samples.begin() + 1050));
+
+	// the end of a clip that doesn't loop
+	stream.Seek(c_ClipFrames - 10);
+
+	REQUIRE(stream.Refill() == 10);
+	REQUIRE(Read(stream, 100).size() == 10);
+	REQUIRE(stream.IsFinished());
+	REQUIRE_FALSE(stream.NeedsRefill());
+
+	// looping carries on from the start, even after the end was reached
+	stream.SetLoop(true);
+
+	REQUIRE_FALSE(stream.IsFinished());
+	REQUIRE(stream.NeedsRefill());
+	REQUIRE(stream.Refill(20) == 20);
+	REQUIRE(Read(stream, 20) == std::vector<sf::Int16>(samples.begin(), samples.begin() + 20));
+
+	stream.AddUnderrun();
+
+	REQUIRE(stream.GetUnderruns() == 1);
+}
+
+TEST_CASE("Decode stream head", "[StreamDecoder]")
+{
+	const auto compressed = LoadCompressed();
+	const auto samples = LoadSamples();
+	const size_t usage = compressed->GetMemoryUsage();
+	constexpr size_t headFrames = 11025; // a quarter second
+
+	REQUIRE(compressed->SetHeadTime(0.25f));
+	REQUIRE(compressed->GetHead()->size() == headFrames);
+	REQUIRE(compressed->GetMemoryUsage() == usage + headFrames * sizeof(sf::Int16));
+
+	Mix::DecodeStream stream;
+
+	REQUIRE(stream.Open(compressed));
+
+	// the head is there before anything is decoded, and the decoder carries on right after it
+	REQUIRE(Read(stream, headFrames) == std::vector<sf::Int16>(samples.begin(), samples.begin() + headFrames));
+	REQUIRE(Read(stream, 100).empty());
+	REQUIRE(stream.Refill(100) == 100);
+	REQUIRE(Read(stream, 100) == std::vector<sf::Int16>(samples.begin() + headFrames, samples.begin() + headFrames + 100));
+
+	// seeking into the head copies it in again, without decoding anything
+	stream.Seek(1000);
+
+	REQUIRE(stream.Refill(0) == 0);
+	REQUIRE(Read(stream, 50) == std::vector<sf::Int16>(samples.begin() + 1000, samples.begin() + 1050));
+
+	// and the decoder carries on where the head stops
+	stream.Seek(headFrames - 25);
+
+	REQUIRE(stream.Refill(75) == 75);
+	REQUIRE(Read(stream, 100) == std::vector<sf::Int16>(samples.begin() + headFrames - 25, samples.begin() + headFrames + 75));
+
+	// streams that are already open keep their head
+	REQUIRE(compressed->SetHeadTime(0.0f));
+	REQUIRE(compressed->GetHead() == nullptr);
+	REQUIRE(compressed->GetMemoryUsage() == usage);
+
+	stream.Seek(0);
+
+	REQUIRE(stream.Refill(0) == 0);
+	REQUIRE(Read(stream, 100) == std::vector<sf::Int16>(samples.begin(), samples.begin() + 100));
+}
+
+TEST_CASE("Decode workers", "[StreamDecoder]")
+{
+	const auto compressed = LoadCompressed();
+	const auto samples = LoadSamples();
+	auto stream = std::make_shared<Mix::DecodeStream>();
+
+	REQUIRE(stream->Open(compressed));
+
+	Mix::StreamDecoder decoder(2);
+
+	decoder.Add(stream);
+
+	REQUIRE(decoder.GetStreamCount() == 1);
+
+	// the workers fill it without being asked
+	const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+
+	while (stream->NeedsRefill() && std::chrono::steady_clock::now() < deadline)
+	{
+		std::this_thread::sleep_for(std::chrono::milliseconds(1));
+	}
+
+	REQUIRE_FALSE(stream->NeedsRefill());
+	REQUIRE(Read(*stream, 1000) == std::vector<sf::Int16>(samples.begin(), samples.begin() + 1000));
+
+	stream->AddUnderrun();
+
+	// removed streams still count towards the total
+	REQUIRE(decoder.GetUnderruns() == 1);
+
+	decoder.Remove(stream);
+
+	REQUIRE(decoder.GetStreamCount() == 0);
+	REQUIRE(decoder.GetUnderruns() == 1);
+}
\ No newline at end of file